@@ -14,9 +14,20 @@
 #include <algorithm>
 #include<tuple>
 #include <queue>
-#include <map>
-#include <list>
+#include <functional>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <bit>
+#include <span>
+#include <string_view>
+#include <cerrno>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 struct Position
 {
@@ -273,15 +284,412 @@ protected:
     size_t _nb_elements{};
 };
 
+/**
+ * @brief A fixed-capacity 2d grid stored inline, without any heap allocation
+ * the row stride is rounded up to a power of two so the index of (X, Y) is (Y << SHIFT) | X
+ * @param T the type stored in the FixedGrid
+ * @param MaxW the maximum width of the grid
+ * @param MaxH the maximum height of the grid
+ */
+template<typename T, size_t MaxW, size_t MaxH>
+class FixedGrid{
+
+public:
+
+    static constexpr size_t STRIDE = std::bit_ceil(MaxW);
+    static constexpr int SHIFT = std::countr_zero(STRIDE);
+    static constexpr size_t CAPACITY = STRIDE * MaxH;
+
+    /**
+     * @brief the linear index of a coordinate
+     * @param X the x coordinate in the FixedGrid
+     * @param Y the y coordinate in the FixedGrid
+     * @return the index to use with operator[]
+     */
+    [[nodiscard]] static constexpr
+    size_t index(size_t X, size_t Y) noexcept {
+        return (Y << SHIFT) | X;
+    }
+
+    /**
+     * @brief operator() to access data
+     * @param X the x coordinate in the FixedGrid
+     * @param Y the y coordinate in the FixedGrid
+     * @return a reference to the element
+     */
+    [[nodiscard]] constexpr
+    T& operator()(size_t X, size_t Y) noexcept {
+        return _data[index(X, Y)];
+    }
+
+    [[nodiscard]] constexpr
+    const T& operator()(size_t X, size_t Y) const noexcept {
+        return _data[index(X, Y)];
+    }
+
+    /**
+     * @brief operator[] to access data by linear index
+     * @param i the index given by index(X, Y)
+     * @return a reference to the element
+     */
+    [[nodiscard]] constexpr
+    T& operator[](size_t i) noexcept {
+        return _data[i];
+    }
+
+    [[nodiscard]] constexpr
+    const T& operator[](size_t i) const noexcept {
+        return _data[i];
+    }
+
+    /**
+     * @brief set every element, padding included
+     * @param value the value to copy everywhere
+     */
+    constexpr void fill(const T& value) noexcept {
+        _data.fill(value);
+    }
+
+    [[nodiscard]] constexpr
+    size_t size() const noexcept {
+        return CAPACITY;
+    }
+
+    constexpr auto begin() noexcept {
+        return _data.begin();
+    }
+
+    constexpr auto begin() const noexcept {
+        return _data.begin();
+    }
+
+    constexpr auto end() noexcept {
+        return _data.end();
+    }
+
+    constexpr auto end() const noexcept {
+        return _data.end();
+    }
+
+private:
+
+    std::array<T, CAPACITY> _data{};
+};
+
+
+
+/**
+ * @brief grille de bits pour les masques du plateau (cases praticables, frontieres, voisines de recyclers...)
+ * chaque ligne occupe 32 bits et la grille fait au plus 16 lignes, soit 8 mots de 64 bits
+ * (la taille de deux registres AVX2) : une dilatation aux 4 ou 8 voisins ne coute que quelques decalages
+ * @note les colonnes au dela de la largeur du plateau servent de bordure : il faut toujours
+ * masquer le resultat d'une dilatation avec le masque des cases du plateau
+ */
+class BitGrid {
+
+public:
+
+    static constexpr int ROW_BITS = 32;
+    static constexpr int MAX_ROWS = 16;
+    static constexpr int NB_WORDS = ROW_BITS * MAX_ROWS / 64;
+
+    /**
+     * @brief test if a cell is in the grid
+     * @param X the x coordinate of the cell
+     * @param Y the y coordinate of the cell
+     * @return true if the bit of the cell is set
+     */
+    [[nodiscard]] constexpr
+    bool test(int X, int Y) const noexcept {
+        const int bit = Y * ROW_BITS + X;
+        return (_words[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    constexpr void set(int X, int Y) noexcept {
+        const int bit = Y * ROW_BITS + X;
+        _words[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+    }
+
+    /**
+     * @brief ajoute d'un coup les bits d'une ligne (bit x = colonne x)
+     * @param Y the row
+     * @param bits the cells of the row to set
+     */
+    constexpr void set_row(int Y, std::uint32_t bits) noexcept {
+        _words[Y >> 1] |= std::uint64_t(bits) << ((Y & 1) * ROW_BITS);
+    }
+
+    constexpr void reset(int X, int Y) noexcept {
+        const int bit = Y * ROW_BITS + X;
+        _words[bit >> 6] &= ~(std::uint64_t(1) << (bit & 63));
+    }
+
+    constexpr void clear() noexcept {
+        _words.fill(0);
+    }
+
+    /**
+     * @brief get the number of cells in the grid
+     * @param none
+     * @return the number of set bits
+     */
+    [[nodiscard]] constexpr
+    int count() const noexcept {
+        int total = 0;
+        for(const auto& word : _words){
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    [[nodiscard]] constexpr
+    bool none() const noexcept {
+        std::uint64_t any = 0;
+        for(const auto& word : _words){
+            any |= word;
+        }
+        return any == 0;
+    }
+
+    constexpr BitGrid& operator|=(const BitGrid& other) noexcept {
+        for(int i = 0; i < NB_WORDS; i++){ _words[i] |= other._words[i]; }
+        return *this;
+    }
+
+    constexpr BitGrid& operator&=(const BitGrid& other) noexcept {
+        for(int i = 0; i < NB_WORDS; i++){ _words[i] &= other._words[i]; }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr
+    BitGrid operator|(const BitGrid& other) const noexcept {
+        BitGrid result(*this);
+        return result |= other;
+    }
+
+    [[nodiscard]] constexpr
+    BitGrid operator&(const BitGrid& other) const noexcept {
+        BitGrid result(*this);
+        return result &= other;
+    }
+
+    /**
+     * @brief the cells of this grid that are not in the other one
+     * (there is no operator~ since it would set the border bits)
+     * @param other the grid to remove
+     * @return this & ~other
+     */
+    [[nodiscard]] constexpr
+    BitGrid and_not(const BitGrid& other) const noexcept {
+        BitGrid result;
+        for(int i = 0; i < NB_WORDS; i++){ result._words[i] = _words[i] & ~other._words[i]; }
+        return result;
+    }
+
+    [[nodiscard]] constexpr
+    bool operator==(const BitGrid& other) const noexcept = default;
+
+    /**
+     * @brief a 64 bits hash of the grid, the same for two grids with the same cells
+     * @param none
+     * @return the hash
+     */
+    [[nodiscard]] constexpr
+    std::uint64_t hash() const noexcept {
+        std::uint64_t h = 0;
+        for(const auto& word : _words){
+            h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 32;
+        }
+        return h;
+    }
+
+    /**
+     * @brief the cells that have at least one orthogonal neighbour in this grid
+     * @param inside the mask of the cells of the board
+     * @return the neighbours, without the border bits
+     */
+    [[nodiscard]] constexpr
+    BitGrid neighbours4(const BitGrid& inside) const noexcept {
+        BitGrid result = shifted_up(1) | shifted_down(1) | shifted_up(ROW_BITS) | shifted_down(ROW_BITS);
+        return result &= inside;
+    }
+
+    /**
+     * @brief the cells that have at least one neighbour (diagonals included) in this grid
+     * @param inside the mask of the cells of the board
+     * @return the neighbours, without the border bits
+     */
+    [[nodiscard]] constexpr
+    BitGrid neighbours8(const BitGrid& inside) const noexcept {
+        const BitGrid horizontal = shifted_up(1) | shifted_down(1);
+        const BitGrid row = horizontal | *this;
+        BitGrid result = horizontal | row.shifted_up(ROW_BITS) | row.shifted_down(ROW_BITS);
+        return result &= inside;
+    }
+
+    /**
+     * @brief call a function on every cell of the grid, row by row
+     * @param F a callable taking (int x, int y)
+     * @param function the function to call
+     */
+    template<typename F>
+    constexpr void for_each(F&& function) const {
+        for(int i = 0; i < NB_WORDS; i++){
+            std::uint64_t word = _words[i];
+            while(word != 0){
+                const int bit = i * 64 + std::countr_zero(word);
+                function(bit % ROW_BITS, bit / ROW_BITS);
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+
+    //decalage vers les bits de poids fort (x + n, ou y + 1 pour n = ROW_BITS), 0 < n < 64
+    [[nodiscard]] constexpr
+    BitGrid shifted_up(int n) const noexcept {
+        BitGrid result;
+        result._words[0] = _words[0] << n;
+        for(int i = 1; i < NB_WORDS; i++){
+            result._words[i] = (_words[i] << n) | (_words[i - 1] >> (64 - n));
+        }
+        return result;
+    }
+
+    //decalage vers les bits de poids faible (x - n, ou y - 1 pour n = ROW_BITS), 0 < n < 64
+    [[nodiscard]] constexpr
+    BitGrid shifted_down(int n) const noexcept {
+        BitGrid result;
+        for(int i = 0; i < NB_WORDS - 1; i++){
+            result._words[i] = (_words[i] >> n) | (_words[i + 1] << (64 - n));
+        }
+        result._words[NB_WORDS - 1] = _words[NB_WORDS - 1] >> n;
+        return result;
+    }
+
+    std::array<std::uint64_t, NB_WORDS> _words{};
+};
+
+
+
+/**
+ * @brief ensemble de cases de taille fixe (un bit par case) pour les cases a eviter ou deja choisies
+ * @example  CellSet to_dodge;
+ *           to_dodge.insert(Position(3, 4));
+ *           if(to_dodge.contains(x, y)){...} // O(1), plus de parcours de vecteur
+ */
+class CellSet {
+
+public:
+
+    constexpr void insert(int X, int Y) noexcept {
+        _cells.set(X, Y);
+    }
+
+    constexpr void insert(const Position& pos) noexcept {
+        _cells.set(pos.x, pos.y);
+    }
+
+    constexpr void erase(int X, int Y) noexcept {
+        _cells.reset(X, Y);
+    }
+
+    [[nodiscard]] constexpr
+    bool contains(int X, int Y) const noexcept {
+        return _cells.test(X, Y);
+    }
+
+    [[nodiscard]] constexpr
+    bool contains(const Position& pos) const noexcept {
+        return _cells.test(pos.x, pos.y);
+    }
+
+    /**
+     * @brief get the number of cells in the set
+     * @param none
+     * @return the number of cells
+     */
+    [[nodiscard]] constexpr
+    int size() const noexcept {
+        return _cells.count();
+    }
+
+    [[nodiscard]] constexpr
+    bool empty() const noexcept {
+        return _cells.none();
+    }
+
+    constexpr void clear() noexcept {
+        _cells.clear();
+    }
+
+    constexpr CellSet& operator|=(const CellSet& other) noexcept {
+        _cells |= other._cells;
+        return *this;
+    }
+
+    constexpr CellSet& operator&=(const CellSet& other) noexcept {
+        _cells &= other._cells;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr
+    CellSet operator|(const CellSet& other) const noexcept {
+        CellSet result(*this);
+        return result |= other;
+    }
+
+    [[nodiscard]] constexpr
+    CellSet operator&(const CellSet& other) const noexcept {
+        CellSet result(*this);
+        return result &= other;
+    }
+
+    [[nodiscard]] constexpr
+    std::uint64_t hash() const noexcept {
+        return _cells.hash();
+    }
+
+    [[nodiscard]] constexpr
+    bool operator==(const CellSet& other) const noexcept = default;
+
+    /**
+     * @brief get the cells as a BitGrid to combine them with the board masks
+     * @param none
+     * @return a const reference to the grid
+     */
+    [[nodiscard]] constexpr
+    const BitGrid& grid() const noexcept {
+        return _cells;
+    }
+
+    /**
+     * @brief call a function on every cell of the set
+     * @param F a callable taking (int x, int y)
+     * @param function the function to call
+     */
+    template<typename F>
+    constexpr void for_each(F&& function) const {
+        _cells.for_each(std::forward<F>(function));
+    }
+
+private:
+
+    BitGrid _cells;
+};
+
 
 
 /** 
  * @brief  pour formaté les commandes à utiliser pour le jeu
- * @example  -Command moveCommand(Command::MOVE, 5, 0, 1, 1, 2);
- *           -Command buildCommand(Command::BUILD, 3, 4);
- *           -Command spawnCommand(Command::SPAWN, 10, 1, 0);
- *           -Command waitCommand(Command::WAIT);
- *           -Command messageCommand(Command::MESSAGE, "Hello World!");
+ * une commande ne s'affiche plus toute seule : elle est ajoutee a un CommandBatch
+ * @example  -batch.push(Command(Command::MOVE, 5, 0, 1, 1, 2, -1, -1));
+ *           -batch.push(Command(Command::BUILD, 1, -1, -1, -1, -1, 3, 4));
+ *           -batch.push(Command(Command::SPAWN, 10, -1, -1, -1, -1, 1, 0));
+ *           -batch.push(Command(Command::WAIT));
+ *           -batch.push(Command(Command::MESSAGE, "Hello World!"));
  */
 class Command {
     public:
@@ -302,11 +710,7 @@ class Command {
 
         Command(Type _type) : type(std::move(_type)) 
         {
-            if(type == Type::WAIT)
-            {
-                std::cout<<"WAIT;";
-            }
-            else
+            if(type != Type::WAIT)
             {
                 throw std::invalid_argument("Error : Command type not found");
             }
@@ -316,19 +720,7 @@ class Command {
             : type(std::move(_type)), amount(std::move(_amount)), origin(std::move(_fromX), std::move(_fromY))
             , destination(std::move(_toX), std::move(_toY)), position(std::move(_x), std::move(_y)) 
         {
-            if(type == Type::MOVE)
-            {
-                std::cout << "MOVE" << " " << amount <<" " << origin.x << " " << origin.y << " " << destination.x << " " << destination.y << ";" ;
-            }
-            else if(type == Type::BUILD)
-            {
-                std::cout << "BUILD" << " " << position.x << " " << position.y << ";";
-            }
-            else if(type == Type::SPAWN)
-            {
-                std::cout << "SPAWN" << " " << amount << " " << position.x << " " << position.y << ";";
-            }
-            else
+            if(type != Type::MOVE && type != Type::BUILD && type != Type::SPAWN)
             {
                 throw std::invalid_argument("Error : Command type not found");
             }
@@ -336,225 +728,797 @@ class Command {
 
         Command(Type _type, std::string _message) : type(std::move(_type)), message(std::move(_message)) 
         {
-            if(type == Type::MESSAGE)
-            {
-                std::cout << "MESSAGE" << " " << message << ";";
-            }
-            else
+            if(type != Type::MESSAGE)
             {
                 throw std::invalid_argument("Error : Command type not found");
             }
         }
 };
 
-class Game_data
-{
+/**
+ * @brief les commandes d'un tour, formatees a la main dans un buffer alloue une seule fois
+ * puis envoyees d'un bloc (un fwrite suivi d'un fflush) sur la sortie standard
+ * @example  CommandBatch batch;
+ *           batch.move(1, 0, 1, 1, 1);
+ *           batch.message("12");
+ *           batch.flush(); // "MOVE 1 0 1 1 1;MESSAGE 12;\n"
+ */
+class CommandBatch {
     public:
-        int my_matter;
-        int opp_matter;
-        int nb_tour = 0;//voir si c est bien 0 au depart
-        //TODO : Rajouter attribut pour les données general du jeu qu on pourrait avoir besoin par la suite de determiner
-        //...
+        static constexpr size_t CAPACITE = 1 << 16;
+        static constexpr size_t TAILLE_MAX_COMMANDE = 64;//la plus longue commande hors message : "MOVE" + 5 entiers
 
-        void update()
+        CommandBatch() : buffer(CAPACITE) {}
+
+        void move(const int amount, const int from_x, const int from_y, const int to_x, const int to_y)
         {
-            nb_tour++;
-            std::cin >> my_matter >> opp_matter; std::cin.ignore();
+            reserver(TAILLE_MAX_COMMANDE);
+            ajouter("MOVE ");
+            ajouter_entier(amount);
+            ajouter(' ');
+            ajouter_entier(from_x);
+            ajouter(' ');
+            ajouter_entier(from_y);
+            ajouter(' ');
+            ajouter_entier(to_x);
+            ajouter(' ');
+            ajouter_entier(to_y);
+            ajouter(';');
+            nb_commandes++;
+        }
+
+        void build(const int x, const int y)
+        {
+            reserver(TAILLE_MAX_COMMANDE);
+            ajouter("BUILD ");
+            ajouter_entier(x);
+            ajouter(' ');
+            ajouter_entier(y);
+            ajouter(';');
+            nb_commandes++;
         }
 
-        //TODO : Add fonction pour des operations lie au donnees general du jeu
-        //...
-};
-
-/**
- * @brief Class that represent the board of the game
- */
-class Board {
-
-    private:
-        struct Neighboor
+        void spawn(const int amount, const int x, const int y)
         {
-            int x;
-            int y;
-            bool is_exist;
-        };
-        typedef Neighboor* p_neighbour;
-        
-        struct Case 
+            reserver(TAILLE_MAX_COMMANDE);
+            ajouter("SPAWN ");
+            ajouter_entier(amount);
+            ajouter(' ');
+            ajouter_entier(x);
+            ajouter(' ');
+            ajouter_entier(y);
+            ajouter(';');
+            nb_commandes++;
+        }
+
+        void wait()
         {
-            int scrap_amount;
-            int owner; // 1 = me, 0 = foe, -1 = neutral
-            int units;
-            int recycler;
-            int can_build;
-            int can_spawn;
-            int in_range_of_recycler;
-            int x;
-            int y;
-            std::array<Neighboor, 8> neighbours;// -1 = no neighbour
-        };
-        typedef Case* p_case;
+            reserver(TAILLE_MAX_COMMANDE);
+            ajouter("WAIT;");
+            nb_commandes++;
+        }
 
-        int width;//x
-        int height;//y
-        
-        Vector2d<Case> board;
-        std::vector<Case> cells_opponent;
-        std::vector<Case> my_cells;
-        std::vector<Case> neutral_cells;
+        void message(const std::string_view texte)
+        {
+            reserver(texte.size() + TAILLE_MAX_COMMANDE);
+            ajouter("MESSAGE ");
+            ajouter(texte);
+            ajouter(';');
+            nb_commandes++;
+        }
 
-    public:
-        Board() 
+        /**
+         * @brief ajoute une Command deja construite
+         */
+        void push(const Command& commande)
         {
-            std::cin >> width >> height; std::cin.ignore();
-            // std::clog << "width: " << width << " " << "height: " << height << std::endl;
-            board.resize(width, height);//Ligne importante pour redimensionner un vector 2D
-            //std::clog << "width: " << width << " " << "height: " << height << std::endl;
-            std::clog << "----------test case voisine\n";
-            for (int x = 0; x < width; x++) 
+            switch(commande.type)
             {
-                for (int y = 0; y < height; y++) 
-                {
-                    determinate_neighboors(x, y);
-                    /*std::clog << "x : " << x << " " << "y : " << y <<" \n";
-                    //test affichage
-                    for(int i = 0; i < 8; i++)
-                    {
-                        std::clog << board(x,y).neighbours[i].x << " " << board(x,y).neighbours[i].y
-                                  << " " << (board(x,y).neighbours[i].is_exist ? "True" : "False") << std::endl;
-                    }*/
+                case Command::MOVE:
+                    move(commande.amount, commande.origin.x, commande.origin.y, commande.destination.x, commande.destination.y);
+                    break;
+                case Command::BUILD:
+                    build(commande.position.x, commande.position.y);
+                    break;
+                case Command::SPAWN:
+                    spawn(commande.amount, commande.position.x, commande.position.y);
+                    break;
+                case Command::WAIT:
+                    wait();
+                    break;
+                case Command::MESSAGE:
+                    message(commande.message);
+                    break;
+            }
+        }
+
+        //nombre de commandes depuis le dernier flush ou clear
+        int size() const noexcept {
+            return nb_commandes;
+        }
+
+        bool empty() const noexcept {
+            return nb_commandes == 0;
+        }
+
+        //le texte du tour sans le retour a la ligne final, pour les tests
+        std::string_view view() const noexcept {
+            return std::string_view(buffer.data(), taille);
+        }
+
+        void clear() noexcept {
+            taille = 0;
+            nb_commandes = 0;
+        }
+
+        /**
+         * @brief termine la ligne du tour, l'envoie d'un coup et vide le batch
+         * @param sortie le flux de sortie, la sortie standard par defaut
+         * @throw std::runtime_error si l'ecriture echoue
+         */
+        void flush(std::FILE* sortie = stdout)
+        {
+            reserver(1);
+            ajouter('\n');
+            if(std::fwrite(buffer.data(), 1, taille, sortie) != taille || std::fflush(sortie) != 0){
+                throw std::runtime_error("Error : cannot write the commands");
+            }
+            clear();
+        }
+
+    private:
+        std::vector<char> buffer;
+        size_t taille = 0;
+        int nb_commandes = 0;
+
+        void reserver(const size_t n)
+        {
+            if(taille + n > buffer.size()){
+                throw std::length_error("Error : too many commands for the CommandBatch buffer");
+            }
+        }
+
+        void ajouter(const char c) noexcept {
+            buffer[taille++] = c;
+        }
+
+        void ajouter(const std::string_view texte) noexcept {
+            std::copy(texte.begin(), texte.end(), buffer.data() + taille);
+            taille += texte.size();
+        }
+
+        void ajouter_entier(const int valeur) noexcept {
+            unsigned int reste = valeur < 0 ? 0u - static_cast<unsigned int>(valeur) : static_cast<unsigned int>(valeur);
+            char chiffres[10];
+            int nb = 0;
+            do{
+                chiffres[nb++] = static_cast<char>('0' + reste % 10);
+                reste /= 10;
+            }while(reste != 0);
+            if(valeur < 0){
+                ajouter('-');
+            }
+            while(nb > 0){
+                ajouter(chiffres[--nb]);
+            }
+        }
+};
+
+/**
+ * @brief levee quand l'entree se termine : pour le bot, la partie est finie
+ */
+class EndOfInput : public std::runtime_error
+{
+    public:
+        using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief lecteur des entrees du jeu, sans passer par les operator>> de std::cin
+ * sur l'entree standard, les octets sont recuperes par blocs dans un buffer reutilise d'un tour a l'autre
+ * (read(2), ou _read sous Windows) puis les entiers sont decodes a la main ; quand std::cin a ete
+ * redirige (cinInjector dans les tests), les caracteres sont lus directement dans son streambuf,
+ * sans buffer intermediaire, pour qu'aucun reste d'une ancienne source ne puisse etre relu
+ */
+class InputReader
+{
+    public:
+        static constexpr size_t TAILLE_BUFFER = 1 << 16;
+
+        /**
+         * @brief le lecteur unique de l'entree standard
+         */
+        static InputReader& get()
+        {
+            static InputReader lecteur;
+            return lecteur;
+        }
+
+        /**
+         * @brief lit le prochain entier, en sautant les espaces et retours a la ligne avant lui
+         * @throw EndOfInput si l'entree est terminee avant l'entier
+         */
+        int next_int()
+        {
+            synchroniser();
+            int c = peek();
+            while(c == ' ' || c == '\n' || c == '\r' || c == '\t'){
+                avancer();
+                c = peek();
+            }
+            if(c == EOF){
+                throw EndOfInput("Error : end of input while reading an integer");
+            }
+            const bool negatif = (c == '-');
+            if(negatif){avancer();}
+            int valeur = 0;
+            unsigned chiffre = static_cast<unsigned>(peek() - '0');
+            while(chiffre < 10){
+                valeur = valeur * 10 + static_cast<int>(chiffre);
+                avancer();
+                chiffre = static_cast<unsigned>(peek() - '0');
+            }
+            return negatif ? -valeur : valeur;
+        }
+
+        /**
+         * @brief lit n entiers d'un coup
+         */
+        template<size_t N>
+        void next_ints(std::array<int, N>& valeurs)
+        {
+            for(int& valeur : valeurs){
+                valeur = next_int();
+            }
+        }
+
+    private:
+        //streambuf de std::cin au demarrage du programme, avant tout cinInjector
+        inline static std::streambuf* const rdbuf_stdin = std::cin.rdbuf();
+
+        std::vector<char> buffer = std::vector<char>(TAILLE_BUFFER);
+        size_t debut = 0;
+        size_t fin = 0;
+        std::streambuf* source = nullptr;
+
+        InputReader() = default;
+
+        //le buffer ne sert qu'a l'entree standard : s'il reste des octets, ils appartiennent a l'entree standard
+        //et sont gardes pour son retour ; une autre source est lue directement dans son streambuf
+        void synchroniser()
+        {
+            source = std::cin.rdbuf();
+        }
+
+        int peek()
+        {
+            if(source != rdbuf_stdin){
+                return source->sgetc();
+            }
+            if(debut == fin && !remplir()){
+                return EOF;
+            }
+            return static_cast<unsigned char>(buffer[debut]);
+        }
+
+        void avancer()
+        {
+            if(source != rdbuf_stdin){
+                source->sbumpc();
+            }
+            else{
+                debut++;
+            }
+        }
+
+        bool remplir()
+        {
+            debut = 0;
+            fin = 0;
+#ifdef _WIN32
+            const int lus = _read(_fileno(stdin), buffer.data(), static_cast<unsigned int>(buffer.size()));
+#else
+            ssize_t lus;
+            do{
+                lus = ::read(STDIN_FILENO, buffer.data(), buffer.size());
+            }while(lus < 0 && errno == EINTR);
+#endif
+            fin = lus > 0 ? static_cast<size_t>(lus) : 0;
+            return fin > 0;
+        }
+};
+
+/**
+ * @brief budget de temps d'un tour
+ * l'horloge demarre des que l'entree du tour est lue ; chaque phase de l'IA ouvre une tranche
+ * du temps restant avec begin_phase() et ses boucles consultent should_stop() pour rendre
+ * leur meilleur resultat partiel au lieu de depasser la limite de l'arbitre
+ */
+class TurnBudget
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr Clock::duration LIMITE_PREMIER_TOUR = std::chrono::milliseconds(1000);
+        static constexpr Clock::duration LIMITE_TOUR = std::chrono::milliseconds(50);
+        static constexpr Clock::duration MARGE = std::chrono::milliseconds(8);//formatage, ecriture de la sortie et gigue de l'arbitre
+
+        /**
+         * @brief demarre le tour avec la limite du jeu (1000ms au premier tour, 50ms ensuite) moins la marge
+         */
+        void start(const bool premier_tour)
+        {
+            start((premier_tour ? LIMITE_PREMIER_TOUR : LIMITE_TOUR) - MARGE);
+        }
+
+        void start(const Clock::duration budget)
+        {
+            debut = Clock::now();
+            fin_tour = debut + budget;
+            fin_phase = fin_tour;
+        }
+
+        /**
+         * @brief ouvre une phase qui peut consommer au plus la fraction part du temps restant
+         * le temps qu'une phase n'utilise pas revient aux phases suivantes
+         */
+        void begin_phase(const double part)
+        {
+            const Clock::time_point maintenant = Clock::now();
+            const Clock::duration reste = fin_tour > maintenant ? fin_tour - maintenant : Clock::duration::zero();
+            fin_phase = maintenant + std::chrono::duration_cast<Clock::duration>(reste * part);
+        }
+
+        //vrai quand la phase courante a epuise sa tranche
+        bool should_stop() const {return Clock::now() >= fin_phase;}
+
+        //vrai quand il reste moins de seuil avant la fin du tour
+        bool is_short(const Clock::duration seuil) const {return remaining() < seuil;}
+
+        Clock::duration remaining() const
+        {
+            const Clock::time_point maintenant = Clock::now();
+            return fin_tour > maintenant ? fin_tour - maintenant : Clock::duration::zero();
+        }
+
+        Clock::duration elapsed() const {return Clock::now() - debut;}
+
+    private:
+        //tant que start() n'a pas ete appele, le budget est illimite
+        Clock::time_point debut = Clock::now();
+        Clock::time_point fin_tour = Clock::time_point::max();
+        Clock::time_point fin_phase = Clock::time_point::max();
+};
+
+/**
+ * @brief mesures de duree des phases de l'IA sur toute la partie
+ * chaque phase garde un echantillon par tour (quelques centaines sur une partie), ce qui suffit
+ * pour donner les percentiles exacts et un histogramme par tranches a la fin de la partie ;
+ * la phase TOUR contient le total de chaque tour, de la lecture de l'entree jusqu'a l'ecriture
+ */
+class PhaseTelemetry
+{
+    public:
+        enum Phase {RECYCLERS, DEFENSE, SPAWNS, CAPTURE, CAPTURE_VIDE, TOUR, NB_PHASES};
+        static constexpr std::array<std::string_view, NB_PHASES> NOMS = {"recyclers", "defense", "spawns", "capture", "capture_vide", "tour"};
+        //bornes superieures des tranches de l'histogramme en microsecondes, la derniere tranche est ouverte
+        static constexpr std::array<int64_t, 8> TRANCHES_US = {100, 500, 1000, 2000, 5000, 10000, 20000, 45000};
+
+        struct Resume
+        {
+            size_t nb = 0;
+            int64_t p50 = 0, p95 = 0, p99 = 0, max = 0, total = 0;//en microsecondes
+            std::array<size_t, TRANCHES_US.size() + 1> histogramme{};
+        };
+
+        void record(const Phase phase, const TurnBudget::Clock::duration duree)
+        {
+            echantillons[phase].push_back(std::chrono::duration_cast<std::chrono::microseconds>(duree).count());
+        }
+
+        /**
+         * @brief percentiles au rang le plus proche sur les echantillons de la phase
+         */
+        Resume summary(const Phase phase) const
+        {
+            Resume resume;
+            std::vector<int64_t> tries = echantillons[phase];
+            resume.nb = tries.size();
+            if(tries.empty()){return resume;}
+            std::sort(tries.begin(), tries.end());
+            auto rang = [&](const int pourcent){
+                return tries[(tries.size() * pourcent + 99) / 100 - 1];
+            };
+            resume.p50 = rang(50);
+            resume.p95 = rang(95);
+            resume.p99 = rang(99);
+            resume.max = tries.back();
+            for(const int64_t duree : tries){
+                resume.total += duree;
+                resume.histogramme[std::lower_bound(TRANCHES_US.begin(), TRANCHES_US.end(), duree) - TRANCHES_US.begin()]++;
+            }
+            return resume;
+        }
+
+        /**
+         * @brief ecrit une ligne par phase mesuree : nombre, p50/p95/p99/max, total puis l'histogramme,
+         * et une derniere ligne avec les succes et les echecs du cache de chemins
+         */
+        void dump(std::ostream& sortie) const
+        {
+            sortie << "phase nb p50_us p95_us p99_us max_us total_us | histogramme <=";
+            for(const int64_t borne : TRANCHES_US){
+                sortie << ' ' << borne;
+            }
+            sortie << " >\n";
+            for(int phase = 0; phase < NB_PHASES; phase++){
+                const Resume resume = summary(static_cast<Phase>(phase));
+                if(resume.nb == 0){continue;}
+                sortie << NOMS[phase] << ' ' << resume.nb << ' ' << resume.p50 << ' ' << resume.p95 << ' '
+                       << resume.p99 << ' ' << resume.max << ' ' << resume.total << " |";
+                for(const size_t compte : resume.histogramme){
+                    sortie << ' ' << compte;
                 }
+                sortie << '\n';
+            }
+            if(cache_hits + cache_misses > 0){
+                sortie << "cache_chemins hits " << cache_hits << " misses " << cache_misses << '\n';
             }
-            std::clog << "----------\n";
         }
 
-        //Fonction qui permet de determiner les voisins de chaque case (si pas de voisin alors -1)
-        // à apeler dans le constructeur juste apres le resize afin de donner à chaque case du plateau de jeu ses voisins
-        void determinate_neighboors(int x, int y) noexcept
+        //totaux du cache de chemins de Graphe, repris a chaque tour
+        void set_cache_stats(const int hits, const int misses)
         {
-            char compteurNeighboors = 0;
-            // N := {-1, 0, 1}
-            for(int i = -1; i <= 1; i++){ // i ∈ N
-                for(int j = -1; j <= 1; j++){ // j ∈ N
-                    // {i, j} ∈ N²
-                    if(i == 0 && j == 0){
-                        continue;
-                    }
-                    // {i, j} ∈ N² \ {0, 0}
-                    // n(N) = 3
-                    // n({i, j}) = n(N)² - 1
-                    //           = 9 - 1 = 8
-
-                    // board.is_in_vector(x+i, y+j) ∈ {true, false}
-                    if(board.is_in_vector(x+i, y+j)){
-                        // board(x+i, y+j) ∈ {board} / {board(x, y)}
-                        board(x, y).neighbours[compteurNeighboors].x = x+i;
-                        board(x, y).neighbours[compteurNeighboors].y = y+j;
-                        board(x, y).neighbours[compteurNeighboors].is_exist = true;
-                    }
-                    else{
-                        // board(x+i, y+j) ∈ {∅}
-                        board(x, y).neighbours[compteurNeighboors].x = -1;
-                        board(x, y).neighbours[compteurNeighboors].y = -1;
-                        board(x, y).neighbours[compteurNeighboors].is_exist = false;
-                    }
-                    
-                    compteurNeighboors++;
-                    // compteurNeighboors_l+1 = compteurNeighboors_l + 1
-                    // l ∈ [1, n({i, j})] -> l ∈ [1, 8]
-                    // compteurNeighboors ∈ [0, 7]
+            cache_hits = hits;
+            cache_misses = misses;
+        }
+
+    private:
+        std::array<std::vector<int64_t>, NB_PHASES> echantillons;
+        int cache_hits = 0;
+        int cache_misses = 0;
+};
+
+/**
+ * @brief mesure la duree de vie d'un bloc et l'enregistre dans la phase donnee
+ */
+class ScopedPhaseTimer
+{
+    public:
+        ScopedPhaseTimer(PhaseTelemetry& _telemetrie, const PhaseTelemetry::Phase _phase)
+            : telemetrie(_telemetrie), phase(_phase), debut(TurnBudget::Clock::now()){}
+        ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+        ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+        ~ScopedPhaseTimer()
+        {
+            telemetrie.record(phase, TurnBudget::Clock::now() - debut);
+        }
+
+    private:
+        PhaseTelemetry& telemetrie;
+        const PhaseTelemetry::Phase phase;
+        const TurnBudget::Clock::time_point debut;
+};
+
+class Game_data
+{
+    public:
+        int my_matter;
+        int opp_matter;
+        int nb_tour = 0;//voir si c est bien 0 au depart
+        //TODO : Rajouter attribut pour les données general du jeu qu on pourrait avoir besoin par la suite de determiner
+        //...
+
+        void update()
+        {
+            nb_tour++;
+            InputReader& entree = InputReader::get();
+            my_matter = entree.next_int();
+            opp_matter = entree.next_int();
+        }
+
+        //TODO : Add fonction pour des operations lie au donnees general du jeu
+        //...
+};
+
+/**
+ * @brief Class that represent the board of the game
+ */
+class Board {
+
+    public:
+        /**
+         * @brief directions orthogonales, dans l'ordre des anciens voisins 1, 3, 4 et 6
+         */
+        enum Direction : int { LEFT, UP, DOWN, RIGHT };
+
+        //une ligne d'indices fait toujours 32 cases : la colonne 0 sert de sentinelle a la fois a gauche
+        //de la ligne et a droite de la precedente, et une ligne sentinelle entoure le plateau en haut et en bas
+        static constexpr int STRIDE = BitGrid::ROW_BITS;
+        static constexpr std::array<int, 4> ORTHOGONAL = {-1, -STRIDE, STRIDE, 1};//indexe par Direction
+        static constexpr std::array<int, 4> DIAGONAL = {-STRIDE - 1, STRIDE - 1, -STRIDE + 1, STRIDE + 1};
+        //les 8 voisins dans l'ordre de l'ancien tableau neighbours : x-1 puis x puis x+1, y croissant
+        static constexpr std::array<int, 8> ALL_DIRECTIONS = {-STRIDE - 1, -1, STRIDE - 1, -STRIDE, STRIDE, -STRIDE + 1, 1, STRIDE + 1};
+
+        static constexpr int index(const int x, const int y) noexcept {
+            return (y + 1) * STRIDE + x + 1;
+        }
+
+        //grille par case indicee par Board::index, sentinelles comprises, sans allocation
+        template<typename T>
+        using Grid = FixedGrid<T, STRIDE, BitGrid::MAX_ROWS + 2>;
+        static_assert(Grid<std::int8_t>::STRIDE == STRIDE);
+
+        static constexpr int x_of(const int id) noexcept {
+            return (id & (STRIDE - 1)) - 1;
+        }
+
+        static constexpr int y_of(const int id) noexcept {
+            return id / STRIDE - 1;
+        }
+
+        /**
+         * @brief champs d'une case qui ont change depuis le tour precedent (combinables avec |)
+         */
+        enum Change : std::uint8_t { OWNER = 1, UNITS = 2, SCRAP = 4, RECYCLER = 8, WALKABLE = 16 };
+
+        struct CellChange
+        {
+            int id;//Board::index de la case
+            std::uint8_t fields;//combinaison de Change
+        };
+
+    private:
+        /**
+         * @brief copie en lecture d'une case, reconstruite a la demande depuis les colonnes du plateau
+         */
+        struct Case 
+        {
+            int scrap_amount;
+            int owner; // 1 = me, 0 = foe, -1 = neutral
+            int units;
+            int recycler;
+            int can_build;
+            int can_spawn;
+            int in_range_of_recycler;
+            int x;
+            int y;
+        };
+        typedef Case* p_case;
+
+        /**
+         * @brief une colonne etroite par champ (structure of arrays), indicee par Board::index :
+         * un parcours qui ne teste que owner ou units ne lit que quelques octets par case
+         * les cases sentinelles autour du plateau ressemblent a des trous (scrap 0, neutre, hors plateau)
+         */
+        struct Cells
+        {
+            Grid<std::int8_t> scrap_amount;
+            Grid<std::int8_t> owner;
+            Grid<std::int16_t> units;//une pile d'unites peut depasser 127
+            Grid<std::int8_t> recycler;
+            Grid<std::int8_t> can_build;
+            Grid<std::int8_t> can_spawn;
+            Grid<std::int8_t> in_range_of_recycler;
+            Grid<std::uint8_t> inside;//0 pour les sentinelles
+            Grid<std::uint8_t> walkable;//copie de mask_walkable, 0 pour les sentinelles
+
+            Cells()
+            {
+                owner.fill(-1);//les sentinelles sont neutres, le reste est deja a 0
+            }
+        };
+
+        int width;//x
+        int height;//y
+        
+        Cells cells;
+        //indices des cases par proprietaire, remplis en une passe a chaque update et jamais reallouees
+        std::vector<int> cells_opponent;
+        std::vector<int> my_cells;
+        std::vector<int> neutral_cells;
+
+        //masques de bits remplis a chaque update
+        BitGrid mask_inside;//toutes les cases du plateau
+        BitGrid mask_near_recycler;//cases avec un recycler sur un des 4 voisins
+        BitGrid mask_walkable;
+        BitGrid mask_front;//cases avec une case ennemie (hors recycler) ou neutre sur un des 8 voisins
+        BitGrid mask_front_opponent;//cases avec une case ennemie (hors recycler) sur un des 8 voisins
+        int turn = 0;//numero du tour, incremente a chaque update
+
+        //journal des changements du dernier update, trie par indice
+        Grid<std::uint8_t> change_flags;//par indice, remis a zero a chaque update
+        std::vector<CellChange> changes;
+        std::uint8_t changed_fields = 0;//union des champs modifies sur tout le plateau
+
+    public:
+        Board() 
+        {
+            width = InputReader::get().next_int();
+            height = InputReader::get().next_int();
+            // std::clog << "width: " << width << " " << "height: " << height << std::endl;
+            if(width >= BitGrid::ROW_BITS || height > BitGrid::MAX_ROWS)
+            {
+                throw std::out_of_range("board is too big for the BitGrid masks");
+            }
+            changes.reserve(width * height);
+            cells_opponent.reserve(width * height);
+            my_cells.reserve(width * height);
+            neutral_cells.reserve(width * height);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    mask_inside.set(x, y);
+                    cells.inside[index(x, y)] = 1;
                 }
             }
         }
 
-        void update_cells_opponent()
+        //une seule passe sur la colonne owner : les listes suivent l'ordre des indices (ligne par ligne)
+        //les sentinelles ne sont ni a moi, ni a l'ennemie, ni neutres avec du scrap : pas besoin de les sauter
+        void classify_cells()
         {
             cells_opponent.clear();
-            for (const Case& i : board) {
-                if (i.owner == 0) {
-                    cells_opponent.push_back(i);
+            my_cells.clear();
+            neutral_cells.clear();
+            const int fin = index(width, height - 1);
+            for (int id = index(0, 0); id < fin; id++) {
+                const int owner = cells.owner[id];
+                if (owner == 0) {
+                    cells_opponent.push_back(id);
+                }
+                else if (owner == 1) {
+                    my_cells.push_back(id);
+                }
+                else if (cells.scrap_amount[id] > 0) {
+                    neutral_cells.push_back(id);
                 }
             }
         }
 
-        void update_my_cells()
+        void update_masks()
         {
-            my_cells.clear();
-            for (const Case& i : board) {
-                if (i.owner == 1) {
-                    my_cells.push_back(i);
+            BitGrid scrap_one;
+            BitGrid scrap_more;
+            BitGrid neutral;
+            BitGrid opponent;
+            BitGrid recycler;
+            //une ligne de chaque masque par passe sur les colonnes, sans branche
+            for (int y = 0; y < height; y++) {
+                const std::int8_t* owner = &cells.owner[index(0, y)];
+                const std::int8_t* scrap = &cells.scrap_amount[index(0, y)];
+                const std::int8_t* recycler_cells = &cells.recycler[index(0, y)];
+                std::uint32_t opponent_row = 0, neutral_row = 0, recycler_row = 0, one = 0, more = 0;
+                for (int x = 0; x < width; x++) {
+                    opponent_row |= std::uint32_t(owner[x] == 0) << x;
+                    neutral_row |= std::uint32_t(owner[x] == -1 && scrap[x] > 0) << x;
+                    recycler_row |= std::uint32_t(recycler_cells[x] == 1) << x;
+                    one |= std::uint32_t(scrap[x] == 1) << x;
+                    more |= std::uint32_t(scrap[x] > 1) << x;
+                }
+                opponent.set_row(y, opponent_row);
+                neutral.set_row(y, neutral_row);
+                recycler.set_row(y, recycler_row);
+                scrap_one.set_row(y, one);
+                scrap_more.set_row(y, more);
+            }
+            mask_near_recycler = recycler.neighbours4(mask_inside);
+            mask_walkable = (scrap_more | scrap_one.and_not(mask_near_recycler)).and_not(recycler);
+            const BitGrid opponent_cells = opponent.and_not(recycler);
+            mask_front_opponent = opponent_cells.neighbours8(mask_inside);
+            mask_front = (opponent_cells | neutral).neighbours8(mask_inside);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    const int id = index(x, y);
+                    const std::uint8_t walkable = mask_walkable.test(x, y);
+                    change_flags[id] |= (cells.walkable[id] != walkable) * WALKABLE;
+                    cells.walkable[id] = walkable;
                 }
             }
         }
 
-        void update_neutral_cells()
+        //compacte les drapeaux par case en une liste de changements
+        void collect_changes()
         {
-            neutral_cells.clear();
-            for (const Case& i : board) {
-                if (i.owner == -1 && i.scrap_amount > 0) {
-                    neutral_cells.push_back(i);
+            changes.clear();
+            changed_fields = 0;
+            const int fin = index(width, height - 1);
+            for (int id = index(0, 0); id < fin; id++) {
+                if (change_flags[id] != 0) {
+                    changes.push_back(CellChange{id, change_flags[id]});
+                    changed_fields |= change_flags[id];
+                    change_flags[id] = 0;
                 }
             }
         }
 
         void update()
         {
-            for (int i = 0; i < height; i++) {
-                for (int j = 0; j < width; j++) {
-                    // TODO : don't use temporary variables to store them into the class.
-                    int scrap_amount;
-                    int owner; // 1 = me, 0 = foe, -1 = neutral
-                    int units;
-                    int recycler;
-                    int can_build;
-                    int can_spawn;
-                    int in_range_of_recycler;
-                    std::cin >> scrap_amount >> owner >> units >> recycler >> can_build >> can_spawn >> in_range_of_recycler; std::cin.ignore();
-                    board(j, i).scrap_amount = scrap_amount;
-                    board(j, i).owner = owner;
-                    board(j, i).units = units;
-                    board(j, i).recycler = recycler;
-                    board(j, i).can_build = can_build;
-                    board(j, i).can_spawn = can_spawn;
-                    board(j, i).in_range_of_recycler = in_range_of_recycler;
-                    board(j, i).x = j;
-                    board(j, i).y = i;
+            turn++;
+            InputReader& entree = InputReader::get();
+            std::array<int, 7> champs;
+            std::uint8_t lus = 0;//champs modifies par la lecture
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {//l'entree arrive ligne par ligne, dans l'ordre des indices
+                    const int id = index(x, y);
+                    entree.next_ints(champs);
+                    change_flags[id] = (cells.owner[id] != champs[1]) * OWNER
+                                     | (cells.units[id] != champs[2]) * UNITS
+                                     | (cells.scrap_amount[id] != champs[0]) * SCRAP
+                                     | (cells.recycler[id] != champs[3]) * RECYCLER;
+                    lus |= change_flags[id];
+                    cells.scrap_amount[id] = champs[0];
+                    cells.owner[id] = champs[1];// 1 = me, 0 = foe, -1 = neutral
+                    cells.units[id] = champs[2];
+                    cells.recycler[id] = champs[3];
+                    cells.can_build[id] = champs[4];
+                    cells.can_spawn[id] = champs[5];
+                    cells.in_range_of_recycler[id] = champs[6];
                 }
             }
 
-            update_cells_opponent();
-            update_my_cells();
-            update_neutral_cells();
-            //affichage cells_opponent
-            /*std::clog << "---------- cells opposent\n";
-            for(int i = 0; i < cells_opponent.size(); i++)
-            {
-                std::clog << "cells_opponent[" << i << "].x: " << cells_opponent[i].x << " " << "cells_opponent[" << i << "].y: " << cells_opponent[i].y << std::endl;
+            //les listes et les masques ne sont recalcules que si un champ dont ils dependent a change
+            if (lus & (OWNER | SCRAP)) {
+                classify_cells();
             }
-            //affichage my_cells
-            std::clog << "---------- my_cells\n";
-            for(int i = 0; i < my_cells.size(); i++)
-            {
-                std::clog << "my_cells[" << i << "].x: " << my_cells[i].x << " " << "my_cells[" << i << "].y: " << my_cells[i].y << std::endl;
+            if (lus & (OWNER | SCRAP | RECYCLER)) {
+                update_masks();
             }
-            //affichage neutral_cells
-            std::clog << "---------- neutral_cells\n";
-            for(int i = 0; i < neutral_cells.size(); i++)
-            {
-                std::clog << "neutral_cells[" << i << "].x: " << neutral_cells[i].x << " " << "neutral_cells[" << i << "].y: " << neutral_cells[i].y << std::endl;
-            }*/
+            collect_changes();
+        }
+
+        bool within_fear_recycler_around(const int x, const int y) const noexcept
+        {
+            return mask_near_recycler.test(x, y);
+        }
+
+        //Une case est praticable si elle n'est pas un recycler et qu'elle ne va pas disparaitre a la fin du tour
+        //(scrap a 1 a cote d'un recycler), regle commune a toutes les cartes de distances
+        bool is_walkable(const int x, const int y) const noexcept
+        {
+            return mask_walkable.test(x, y);
         }
 
         //TODO : Add fonction pour des operations lie au plateau de jeu
         //...
 
-        //Fonction qui retourne un tableau 2d de type vector<vector<Case>>
-        Vector2d<Case>& get_board()  noexcept{
-            return board;
+        bool is_inside(const int x, const int y) const noexcept {
+            return x >= 0 && x < width && y >= 0 && y < height;
+        }
+
+        //les sentinelles sont hors du plateau et jamais praticables
+        bool is_inside(const int id) const noexcept {
+            return cells.inside[id];
         }
 
-        const Vector2d<Case>& get_board() const noexcept{
-            return board;
+        bool is_walkable(const int id) const noexcept {
+            return cells.walkable[id];
+        }
+
+        //nombre d'indices, sentinelles comprises
+        int get_nb_ids() const noexcept {
+            return STRIDE * (height + 2);
+        }
+
+        /**
+         * @brief lecture d'une case a la maniere de l'ancien Vector2d<Case>
+         * @return une copie des champs de la case (x,y)
+         */
+        Case operator()(const int x, const int y) const noexcept {
+            return case_at(index(x, y));
+        }
+
+        Case case_at(const int id) const noexcept {
+            return Case{cells.scrap_amount[id], cells.owner[id], cells.units[id], cells.recycler[id],
+                        cells.can_build[id], cells.can_spawn[id], cells.in_range_of_recycler[id],
+                        x_of(id), y_of(id)};
+        }
+
+        //les lectures board.get_board()(x, y).champ passent par operator()
+        const Board& get_board() const noexcept{
+            return *this;
+        }
+
+        const Cells& get_cells() const noexcept{
+            return cells;
         }
 
         int get_width() const noexcept {
@@ -565,253 +1529,459 @@ class Board {
             return height;
         }
 
-        std::vector<Case>& get_cell_opponent() noexcept {
+        int get_turn() const noexcept {
+            return turn;
+        }
+
+        //cases modifiees par le dernier update, dans l'ordre des indices
+        std::span<const CellChange> get_changes() const noexcept {
+            return changes;
+        }
+
+        std::uint8_t get_changed_fields() const noexcept {
+            return changed_fields;
+        }
+
+        //change a chaque tour ou au moins une case devient praticable ou cesse de l'etre
+        //indices (Board::index) des cases de chaque camp, a lire avec get_cells() ou x_of / y_of
+        std::span<const int> get_cell_opponent() const noexcept {
             return cells_opponent;
         }
 
-        std::vector<Case>& get_my_cells() noexcept {
+        std::span<const int> get_my_cells() const noexcept {
             return my_cells;
         }
 
-        std::vector<Case>& get_neutral_cells() noexcept {
+        std::span<const int> get_neutral_cells() const noexcept {
             return neutral_cells;
         }
-};
 
-//bool within_fear_recycler_around(const int x, const int y);
+        const BitGrid& get_mask_walkable() const noexcept {
+            return mask_walkable;
+        }
 
-class Graphe
-{
-    typedef struct Noeud_graphe
-    {
-        float cout_g, cout_h, cout_f;
-        std::pair<int,int> parent;
-        int distance_center;
-    }Noeud;
+        const BitGrid& get_mask_front() const noexcept {
+            return mask_front;
+        }
 
-    private:
-        typedef std::map<std::pair<int,int>,Noeud> type;
-        type file_open;
-        type file_close;
-        const Board* p_board = nullptr;
-        std::list<Position> chemin;
-        std::vector<Position> array_remove;
-        int from_x;
-        int from_y;
-        int to_x;
-        int to_y;
-        int nb_unite;
+        const BitGrid& get_mask_front_opponent() const noexcept {
+            return mask_front_opponent;
+        }
+};
 
-    public:
-        Graphe(const Board* _board) : p_board(_board){
-            if(p_board == nullptr)
-            {
-                throw std::invalid_argument("board is null");
-            }
-        } 
+/**
+ * @brief les deux valeurs lues par les phases de recyclers, tenues a jour pour chaque case du plateau
+ *   - score : la note de construct_recycler_early_game (ecarts de ferraille avec les voisines)
+ *   - ennemies adjacentes : unites ennemies sur les 4 voisines, pour constrcut_recycler_defense
+ * les recyclers deja poses autour ne sont pas pris en compte.
+ * La passe complete est un stencil a 4 voisins sans branche sur les colonnes contigues du Board,
+ * que le compilateur peut vectoriser ; aux tours suivants seules les cases changees et leurs voisines sont recalculees.
+ */
+class RecyclerMap {
+
+    private:
+        Board::Grid<std::int16_t> score;
+        Board::Grid<std::int16_t> ennemies_adjacentes;
+        int turn_carte = -1;
+        //au dela de ce nombre de cases changees, la passe complete coute moins cher
+        static constexpr size_t SEUIL_PASSE_COMPLETE = 64;
 
-        void init_research_court_chemin(int _from_x, int _from_y, int _to_x, int _to_y, int nb_units, std::vector<Position> &_array_remove)
+        void evaluer(const auto& cells, const int id) noexcept
         {
-            from_x = _from_x;
-            from_y = _from_y;
-            to_x = _to_x;
-            to_y = _to_y;
-            nb_unite = nb_units;
-            array_remove = _array_remove;
+            const int s = cells.scrap_amount[id];
+            int note = s;
+            int ennemies = 0;
+            for(const int direction : Board::ORTHOGONAL){
+                const int voisin = id + direction;
+                const int v = cells.scrap_amount[voisin];
+                note += v == 0 ? -s : (v == s ? -4 : s - v);
+                ennemies += cells.owner[voisin] == 0 ? cells.units[voisin] : 0;
+            }
+            score[id] = static_cast<std::int16_t>(note);
+            ennemies_adjacentes[id] = static_cast<std::int16_t>(ennemies);
         }
 
-        bool within_fear_recycler_around(const int x, const int y)
+    public:
+        /**
+         * @brief met la carte a jour apres Board::update
+         * tout est recalcule au premier tour ou quand beaucoup de cases ont change
+         */
+        void update(const Board& board)
         {
-            const Board& board = *p_board;
-            for(int i = 0; i < 8; i++)
-            {
-                if(i == 1 || i == 3 || i == 4 || i == 6)
-                {
-                    int x_ = board.get_board()(x,y).neighbours[i].x;
-                    int y_ = board.get_board()(x,y).neighbours[i].y;
-                    if(x_ != -1 && y_ != -1){
-                        if(board.get_board()(x_,y_).recycler == 1){return true;}
+            if(turn_carte == board.get_turn()){return;}
+            const bool suite = turn_carte == board.get_turn() - 1;
+            turn_carte = board.get_turn();
+            const auto& cells = board.get_cells();
+            const std::span<const Board::CellChange> changes = board.get_changes();
+
+            if(!suite || changes.size() > SEUIL_PASSE_COMPLETE){
+                const int fin = Board::index(board.get_width() - 1, board.get_height() - 1);
+                for(int id = Board::index(0, 0); id <= fin; id++){
+                    evaluer(cells, id);
+                }
+                return;
+            }
+            for(const Board::CellChange& change : changes){
+                if(!(change.fields & (Board::SCRAP | Board::OWNER | Board::UNITS))){continue;}
+                evaluer(cells, change.id);
+                for(const int direction : Board::ORTHOGONAL){
+                    //les sentinelles ne sont jamais lues et n'ont pas toutes leurs voisines dans la grille
+                    if(board.is_inside(change.id + direction)){
+                        evaluer(cells, change.id + direction);
                     }
-  
                 }
             }
-            return false;
         }
 
-        bool verif_array_remove(const int x, const int y)
-        {
-            for(int i = 0; i < array_remove.size();i++)
-            {
-                if(x == array_remove[i].x && y == array_remove[i].y){return true;}
-            }
-            return false;
+        int get_score(const int id) const noexcept {
+            return score[id];
         }
 
-        bool deja_present_dans_liste(std::pair<int,int> n, type& l){
-            type::iterator i = l.find(n);
-            if (i==l.end())
-                return false;
-            else
-                return true;
+        int get_adjacent_enemies(const int id) const noexcept {
+            return ennemies_adjacentes[id];
         }
+};
 
-        void ajouter_cases_adjacentes(std::pair <int,int>& n)
-        {
-            Noeud tmp;
-            const Board& board = *p_board;
-            for(int k = 0; k < 8; k++)
-            {
-                if(k == 1 || k == 3 || k == 4 || k == 6)
-                {
-                    if(!board.get_board()(n.first,n.second).neighbours[k].is_exist){
-                        continue;
-                    }
+/**
+ * @brief resume d'une recherche de chemin : la seule chose dont les phases de l'IA ont besoin
+ */
+struct PathSummary
+{
+    int length = 0;//nombre de cases du chemin sans la case de depart (1 si deja sur l'arrivee, 0 si inaccessible)
+    Position first_step;//premiere case du chemin (l'arrivee elle meme si on y est deja)
+    bool reachable = false;
+};
 
-                    int x_voisin = board.get_board()(n.first,n.second).neighbours[k].x;
-                    int y_voisin = board.get_board()(n.first,n.second).neighbours[k].y;
+/**
+ * @brief carte des distances (BFS) vers un ensemble de cases sources, calculee en une seule passe O(cases)
+ * @example  DistanceField champ(&board);
+ *           champ.compute(Position(5, 3), position_to_dodge);
+ *           int dist = champ.path_length(x, y); // meme convention que PathSummary::length
+ *           Position pas = champ.first_step(x, y); // premiere case du chemin vers la source la plus proche
+ */
+class DistanceField {
 
-                    if(verif_array_remove(x_voisin, y_voisin))
-                        {continue;}
+    public:
+        static constexpr int INACCESSIBLE = -1;
 
-                    if(board.get_board()(x_voisin,y_voisin).scrap_amount == 1 && !within_fear_recycler_around(x_voisin,y_voisin) && board.get_board()(x_voisin,y_voisin).recycler != 1 || board.get_board()(x_voisin,y_voisin).scrap_amount > 1 && board.get_board()(x_voisin,y_voisin).recycler != 1)
-                    {
-                        if(board.get_board()(x_voisin,y_voisin).owner == -1 || board.get_board()(x_voisin,y_voisin).owner == 1 || board.get_board()(x_voisin,y_voisin).owner == 0)// && board.get_board()(x_voisin,y_voisin).units <= nb_unite)
-                        {   
-                            std::pair<int,int> it(x_voisin,y_voisin);
-                            
-                            if (!deja_present_dans_liste(it, file_close))
-                            {
-                                tmp.cout_g = file_close[n].cout_g + distance(x_voisin,y_voisin,n.first,n.second);
-                                tmp.cout_h = distance(x_voisin,y_voisin,to_x,to_y);
-                                tmp.cout_f = tmp.cout_g + tmp.cout_h;
-                                tmp.parent = n;
-                                tmp.distance_center = get_distance_center(x_voisin,y_voisin,board.get_width(),board.get_height());
-
-                                if (deja_present_dans_liste(it, file_open))
-                                {
-                                    /* le noeud est deja present dans la liste ouverte, il faut comparer les couts */
-                                    if (tmp.cout_f < file_open[it].cout_f){// || (tmp.cout_f == file_open[it].cout_f && tmp.distance_center < file_open[it].distance_center)){//isNearCenter(x_voisin, y_voisin, board.get_width(), board.get_height())
-                                        /* si le nouveau chemin est meilleur, on update */
-                                        file_open[it]=tmp;
-                                    }
-                                    /* le noeud courant a un moins bon chemin, on ne change rien */
-                                }
-                                else
-                                {
-                                    /* le noeud n'est pas present dans la liste ouverte, on l'ajoute */
-                                    file_open[std::pair<int,int>(x_voisin,y_voisin)]=tmp;
-                         
-                               }
-                            }
+    private:
+        const Board* p_board = nullptr;
+        int width = 0;
+        int height = 0;
+        //tableaux indices par Board::index : les sentinelles restent INACCESSIBLE, un voisin se lit sans test de bord
+        Board::Grid<int> distances;//nombre de pas jusqu'a la source la plus proche, INACCESSIBLE sinon
+        Board::Grid<int> next_hops;//index de la case suivante vers la source la plus proche
+        Board::Grid<bool> sources;
+        int nb_ids = 0;//partie utile des grilles, sentinelles comprises
+        std::vector<Position> une_source = std::vector<Position>(1);
+
+        static constexpr int index(const int x, const int y) noexcept {
+            return Board::index(x, y);
+        }
+
+    public:
+        DistanceField(const Board* _board) : p_board(_board) {
+            if(p_board == nullptr)
+            {
+                throw std::invalid_argument("board is null");
+            }
+            width = p_board->get_width();
+            height = p_board->get_height();
+            nb_ids = p_board->get_nb_ids();
+            distances.fill(INACCESSIBLE);
+            next_hops.fill(-1);
+        }
+
+        /**
+         * @brief calcule les distances de chaque case vers la source la plus proche
+         * le BFS avance couche par couche sur les masques de bits : une couche = une dilatation du front
+         * @param _sources les cases de depart du BFS (une source non praticable n'est pas propagee)
+         * @param _to_dodge les cases a ne jamais traverser
+         */
+        void compute(const std::vector<Position>& _sources, const CellSet& _to_dodge)
+        {
+            std::fill_n(distances.begin(), nb_ids, INACCESSIBLE);
+            std::fill_n(next_hops.begin(), nb_ids, -1);
+            std::fill_n(sources.begin(), nb_ids, false);
+
+            const BitGrid passable = p_board->get_mask_walkable().and_not(_to_dodge.grid());
+
+            BitGrid front;
+            for(const Position& pos : _sources){
+                const int i = index(pos.x, pos.y);
+                sources[i] = true;
+                if(passable.test(pos.x, pos.y)){
+                    front.set(pos.x, pos.y);
+                    distances[i] = 0;
+                    next_hops[i] = i;
+                }
+            }
+
+            BitGrid visited = front;
+            int couche = 0;
+            while(!front.none()){
+                couche++;
+                front = front.neighbours4(passable).and_not(visited);
+                visited |= front;
+                front.for_each([&](const int x, const int y){
+                    const int i = index(x, y);
+                    distances[i] = couche;
+                    //la case suivante est un voisin de la couche precedente
+                    for(const int direction : Board::ORTHOGONAL){
+                        const int voisin = i + direction;
+                        if(distances[voisin] == couche - 1){
+                            next_hops[i] = voisin;
+                            break;
                         }
                     }
-                }
+                });
             }
         }
 
-        std::pair<int,int> meilleur_noeud(type& l)
+        /**
+         * @brief meme chose avec une seule source, sans allouer de vecteur temporaire
+         */
+        void compute(const Position& source, const CellSet& _to_dodge)
         {
-            float m_coutf = l.begin()->second.cout_f;
-            int distance = l.begin()->second.distance_center;
-            std::pair<int,int> m_noeud = l.begin()->first;
-
-            for (type::iterator i = l.begin(); i!=l.end(); i++)
-            {
-                if (i->second.cout_f < m_coutf){// || (i->second.cout_f == m_coutf && i->second.distance_center < distance)){
-                    m_coutf = i->second.cout_f;
-                    m_noeud = i->first;
-                }
+            une_source[0] = source;
+            compute(une_source, _to_dodge);
+        }
+
+        /**
+         * @brief distance BFS d'une case praticable vers la source la plus proche
+         * @return le nombre de pas, INACCESSIBLE si aucune source n'est atteignable
+         */
+        int get_distance(const int x, const int y) const noexcept {
+            return distances[index(x, y)];
+        }
+
+        /**
+         * @brief longueur du chemin depuis une case quelconque (la case de depart n'a pas besoin d'etre praticable)
+         * @return la convention de PathSummary::length : 0 si inaccessible, 1 si deja sur une source
+         */
+        int path_length(const int x, const int y) const noexcept {
+            if(sources[index(x, y)]){return 1;}
+            const int voisin = best_neighbour(x, y);
+            if(voisin == -1){return 0;}
+            return distances[voisin] + 1;
+        }
+
+        /**
+         * @brief premiere case du chemin depuis une case quelconque vers la source la plus proche
+         * @return la position de la premiere case, Position() si inaccessible
+         */
+        Position first_step(const int x, const int y) const noexcept {
+            if(sources[index(x, y)]){return Position(x, y);}
+            const int voisin = best_neighbour(x, y);
+            if(voisin == -1){return Position();}
+            return Position(Board::x_of(voisin), Board::y_of(voisin));
+        }
+
+        /**
+         * @brief la source atteinte depuis une case praticable en suivant les cases suivantes
+         * @return la position de la source, Position() si inaccessible
+         */
+        Position nearest_source(const int x, const int y) const noexcept {
+            int courant = index(x, y);
+            if(next_hops[courant] == -1){return Position();}
+            while(next_hops[courant] != courant){
+                courant = next_hops[courant];
             }
-            return m_noeud;
+            return Position(Board::x_of(courant), Board::y_of(courant));
         }
 
-        void ajouter_liste_fermee(std::pair<int,int>& p)
-        {
-            Noeud& n = file_open[p];
-            file_close[p]=n;
+        /**
+         * @brief path_length et first_step en un seul appel
+         */
+        PathSummary summary(const int x, const int y) const noexcept {
+            PathSummary resume;
+            resume.length = path_length(x, y);
+            resume.first_step = first_step(x, y);
+            resume.reachable = resume.length > 0;
+            return resume;
+        }
 
-            // il faut le supprimer de la liste ouverte, ce n'est plus une solution explorable
-            if (file_open.erase(p)==0)
-                std::cerr << "n'apparait pas dans la liste ouverte, impossible   supprimer" << std::endl;
-            return;
+    private:
+        int best_neighbour(const int x, const int y) const noexcept {
+            const int i = index(x, y);
+            int best = -1;
+            for(const int direction : Board::ORTHOGONAL){
+                const int voisin = i + direction;
+                if(distances[voisin] == INACCESSIBLE){
+                    continue;
+                }
+                if(best == -1 || distances[voisin] < distances[best]){
+                    best = voisin;
+                }
+            }
+            return best;
         }
+};
 
-        void retrouver_chemin()
+class Graphe
+{
+    private:
+        //un parcours inverse du tour, identifie par sa cible (sa case dans entree_de_cible) et l'ensemble complet des cases a eviter
+        struct ChampCache
         {
-            // l'arrivee est le dernier element de la liste fermee.
-            Noeud& tmp = file_close[std::pair<int, int>(to_x,to_y)];
-
-            Position n;
-            std::pair<int,int> prec;
-            n.x = to_x;
-            n.y = to_y;
-            prec.first  = tmp.parent.first;
-            prec.second = tmp.parent.second;
-            chemin.push_front(n);
+            CellSet to_dodge;
+            DistanceField champ;
+            int suivante;//entree suivante pour la meme cible, AUCUNE_ENTREE en fin de liste
+        };
 
-            while (prec != std::pair<int,int>(from_x,from_y)){
-                n.x = prec.first;
-                n.y = prec.second;
-                chemin.push_front(n);
+        const Board* p_board = nullptr;
+        DistanceField champ_inverse;//pour les parcours depuis les cases de depart et les parcours hors cache
+        std::vector<Position> voisins_depart;//sources du parcours depuis une case de depart
+
+        //cache des parcours inverses : les phases d'un tour cherchent souvent vers les memes piles ennemies
+        //avec les memes cases a eviter ; les entrees sont reutilisees d'un tour a l'autre sans etre reallouees.
+        //une fois les NB_CHAMPS_CACHE entrees du tour prises, les parcours suivants ne sont plus gardes
+        //(les captures, qui viennent en dernier, ne chassent pas les parcours de la defense)
+        static constexpr int NB_CHAMPS_CACHE = 32;
+        static constexpr std::int8_t AUCUNE_ENTREE = -1;
+        std::vector<ChampCache> cache;
+        int nb_entrees = 0;//entrees valides pour le tour turn_cache
+        Board::Grid<std::int8_t> entree_de_cible;//par Board::index de la cible, premiere entree ou AUCUNE_ENTREE
+        int turn_cache = -1;
+        int cache_hits = 0;//depuis le debut de la partie
+        int cache_misses = 0;
+
+        static constexpr int index(const int x, const int y) noexcept {
+            return Board::index(x, y);
+        }
 
-                tmp = file_close[tmp.parent];
-                prec.first  = tmp.parent.first;
-                prec.second = tmp.parent.second;
+    public:
+        Graphe(const Board* _board) : p_board(_board), champ_inverse(_board){
+            if(p_board == nullptr)
+            {
+                throw std::invalid_argument("board is null");
             }
+            cache.reserve(NB_CHAMPS_CACHE);
         }
 
-        void loop_search_chemin()
+        /**
+         * @brief recherche inverse : un seul parcours depuis la cible donne, pour chaque source,
+         * le resume de son chemin vers la cible
+         * @param Source un type avec des membres x et y (Position, Entity...)
+         * @param resultats rempli dans l'ordre des sources
+         */
+        template<typename Source>
+        void search_from_target(int _to_x, int _to_y, const std::vector<Source>& sources, const CellSet& _array_remove, std::vector<PathSummary>& resultats)
         {
-            Noeud depart;
-            depart.parent.first  = from_x;
-            depart.parent.second = from_y;
-
-            std::pair <int,int> courant;
-
-            /* deroulement de l'algo A* */
-
-            courant.first  = from_x;
-            courant.second = from_y;
-            // ajout de courant dans la liste ouverte
-
-            file_open[courant]=depart;
-            ajouter_liste_fermee(courant);
-            ajouter_cases_adjacentes(courant);
-
+            const DistanceField& champ = champ_vers(_to_x, _to_y, _array_remove);
+            resultats.clear();
+            for(const Source& source : sources){
+                resultats.push_back(champ.summary(source.x, source.y));
+            }
+        }
 
-            while( !((courant.first == to_x) && (courant.second == to_y))
-                    &&
-                (!file_open.empty())
-                ){
+        /**
+         * @brief resumes des chemins de plusieurs sources vers plusieurs cibles
+         * un parcours inverse par cible ou un parcours par source, selon le cote le moins nombreux
+         * (un parcours multi-sources commun ne donne que la cible la plus proche, pas la matrice complete)
+         * @param Source, Cible des types avec des membres x et y (Position, Entity...)
+         * @param matrice redimensionnee a (cibles x sources) : matrice(t, s) est le resume du chemin de sources[s] vers cibles[t]
+         */
+        template<typename Source, typename Cible>
+        void search_batch(const std::vector<Source>& sources, const std::vector<Cible>& cibles, const CellSet& _array_remove, Vector2d<PathSummary>& matrice)
+        {
+            matrice.resize(cibles.size(), sources.size());
+            if(cibles.size() <= sources.size()){
+                for(size_t t = 0; t < cibles.size(); t++){
+                    const DistanceField& champ = champ_vers(cibles[t].x, cibles[t].y, _array_remove);
+                    for(size_t s = 0; s < sources.size(); s++){
+                        matrice(t, s) = champ.summary(sources[s].x, sources[s].y);
+                    }
+                }
+            }
+            else{
+                for(size_t s = 0; s < sources.size(); s++){
+                    search_from_start(sources[s].x, sources[s].y, _array_remove);
+                    for(size_t t = 0; t < cibles.size(); t++){
+                        matrice(t, s) = summary_from_start(sources[s].x, sources[s].y, cibles[t].x, cibles[t].y);
+                    }
+                }
+            }
+        }
 
-                // on cherche le meilleur noeud de la liste ouverte, on sait qu'elle n'est pas vide donc il existe
-                courant = meilleur_noeud(file_open);
+        //nombre de parcours inverses evites grace au cache depuis le debut de la partie
+        int get_cache_hits() const noexcept {
+            return cache_hits;
+        }
 
-                // on le passe dans la liste fermee, il ne peut pas deja y etre
-                ajouter_liste_fermee(courant);
+        int get_cache_misses() const noexcept {
+            return cache_misses;
+        }
 
-                ajouter_cases_adjacentes(courant);
+    private:
+        /**
+         * @brief le parcours inverse vers la cible, calcule seulement s'il n'est pas deja dans le cache
+         * seul endroit ou le cache est invalide : il est vide des que le plateau passe au tour suivant
+         * @return une reference valable jusqu'au prochain appel
+         */
+        const DistanceField& champ_vers(const int x, const int y, const CellSet& _to_dodge)
+        {
+            if(turn_cache != p_board->get_turn()){
+                nb_entrees = 0;
+                entree_de_cible.fill(AUCUNE_ENTREE);
+                turn_cache = p_board->get_turn();
+            }
+            const int id = index(x, y);
+            for(int e = entree_de_cible[id]; e != AUCUNE_ENTREE; e = cache[e].suivante){
+                if(cache[e].to_dodge == _to_dodge){
+                    cache_hits++;
+                    return cache[e].champ;
+                }
             }
 
-            if ((courant.first == to_x) && (courant.second == to_y)){
-                retrouver_chemin();
-            }else{
-                    /* pas de solution */
+            cache_misses++;
+            if(nb_entrees == NB_CHAMPS_CACHE){
+                champ_inverse.compute(Position(x, y), _to_dodge);
+                return champ_inverse;
+            }
+            const int e = nb_entrees++;
+            if(e == static_cast<int>(cache.size())){
+                cache.push_back(ChampCache{_to_dodge, DistanceField(p_board), AUCUNE_ENTREE});
             }
+            ChampCache& entree = cache[e];
+            entree.to_dodge = _to_dodge;
+            entree.suivante = entree_de_cible[id];
+            entree_de_cible[id] = static_cast<std::int8_t>(e);
+            entree.champ.compute(Position(x, y), _to_dodge);
+            return entree.champ;
         }
 
-        void clear_list()
+        //parcours depuis une case de depart : le depart n'a pas besoin d'etre praticable (une unite sur une case qui disparait peut encore bouger)
+        //donc le BFS part de ses voisins praticables, et chaque case retrouve son premier pas par nearest_source
+        void search_from_start(const int x, const int y, const CellSet& _array_remove)
         {
-            file_open.clear();
-            file_close.clear();
-            chemin.clear();
-            array_remove.clear();
+            const Board& board = *p_board;
+            voisins_depart.clear();
+            for(const int direction : Board::ORTHOGONAL){
+                const int voisin = index(x, y) + direction;
+                if(board.is_walkable(voisin)){//compute ignore de toute facon les sources non praticables
+                    voisins_depart.push_back(Position(Board::x_of(voisin), Board::y_of(voisin)));
+                }
+            }
+            champ_inverse.compute(voisins_depart, _array_remove);
         }
 
-        std::list<Position>& get_list_chemin() noexcept {
-            return chemin;
+        PathSummary summary_from_start(const int x, const int y, const int _to_x, const int _to_y) const
+        {
+            PathSummary resume;
+            if(x == _to_x && y == _to_y){
+                resume.length = 1;
+                resume.first_step = Position(x, y);
+                resume.reachable = true;
+                return resume;
+            }
+            const int dist = champ_inverse.get_distance(_to_x, _to_y);
+            if(dist == DistanceField::INACCESSIBLE){return resume;}
+            resume.length = dist + 1;
+            resume.first_step = champ_inverse.nearest_source(_to_x, _to_y);
+            resume.reachable = true;
+            return resume;
         }
-        
 };
 
 struct Entity
@@ -823,6 +1993,17 @@ struct Entity
 };
 typedef Entity* p_entity;
 
+/**
+ * @brief une pile d'unites d'un meme camp sur une case : toutes les unites d'une case ont les memes
+ * chemins, les phases de l'IA ne cherchent donc qu'une fois par pile et pas une fois par unite
+ */
+struct UnitStack
+{
+    int x;
+    int y;
+    int count;//nombre d'unites sur la case
+};
+
 /**
  * @brief class that represent a different entities of the game (recycler, unit, ...)
  */
@@ -830,116 +2011,49 @@ class Entities {
 
     private:
         std::vector<Entity> opponent_recycler;
-        std::vector<Entity> opponent_unit;
+        std::vector<UnitStack> opponent_unit;
         std::vector<Entity> my_recycler;
-        std::vector<Entity> my_unit;
+        std::vector<UnitStack> my_unit;
         //TODO : Rajout d'eventuels autre attributs pour les entites
-        //...
-
-    public:
-        Entities(Board const& board)
-        {
-            std::cerr<<"Initialisation des entités"<<std::endl;
-            update_opponent_recycler(board);
-            //Affichage des coordonnées des recyclers ennemis
-            /*for(int i = 0; i < opponent_recycler.size(); i++)
-            {
-                std::cerr << "Recycler ennemi : " << opponent_recycler[i].x << " " << opponent_recycler[i].y << std::endl;
-            }*/
-            update_opponent_unit(board);
-            //Affichage des coordonnées des unités ennemies
-            /*for(int i = 0; i < opponent_unit.size(); i++)
-            {
-                std::cerr << "Unité ennemie : " << opponent_unit[i].x << " " << opponent_unit[i].y << std::endl;
-            }*/
-            update_my_recycler(board);
-            //Affichage des coordonnées des recyclers alliés
-            /*for(int i = 0; i < my_recycler.size(); i++)
-            {
-                std::cerr << "Recycler allié : " << my_recycler[i].x << " " << my_recycler[i].y << std::endl;
-            }*/
-            update_my_unit(board);
-            //Affichage des coordonnées des unités alliées
-            /*for(int i = 0; i < my_unit.size(); i++)
-            {
-                std::cerr << "Unité alliée : " << my_unit[i].x << " " << my_unit[i].y << std::endl;
-            }*/
-            std::cerr<<"Fin de l'initialisation des entités"<<std::endl;
-        }
-
-        //Function that update the array opponent_recycler depuis le tableau board passé en paramètre
-        void update_opponent_recycler(Board const & board)
-        {
-            for(int i = 0; i < board.get_width(); i++)
-            {
-                for(int j = 0; j < board.get_height(); j++)
-                {
-                    if(board.get_board()(i, j).owner == 0 && board.get_board()(i, j).recycler == 1)
-                    {
-                        Entity entity;
-                        entity.x = i;
-                        entity.y = j;
-                        opponent_recycler.push_back(entity);
-                    }
-                }
-            }
-        }
+        //...
 
-        //Function that update the array opponent_unit depuis le tableau board passé en paramètre
-        void update_opponent_unit(Board const& board)
+    public:
+        Entities(Board const& board)
         {
-            for(int i = 0; i < board.get_width(); i++)
-            {
-                for(int j = 0; j < board.get_height(); j++)
-                {
-                    if(board.get_board()(i, j).owner == 0 && board.get_board()(i, j).units > 0)
-                    {
-                        for(int k = 0; k < board.get_board()(i, j).units; k++)
-                        {
-                            Entity entity;
-                            entity.x = i;
-                            entity.y = j;
-                            opponent_unit.push_back(entity);
-                        }
-                    }
-                }
-            }
+            update(board);
         }
 
-        //Function that update the array my_recycler depuis le tableau board passé en paramètre
-        void update_my_recycler(Board const& board)
+        //Function that update all the arrays depuis le tableau board passé en paramètre, en une passe ligne par ligne
+        void update(Board const& board)
         {
-            for(int i = 0; i < board.get_width(); i++)
+            opponent_recycler.clear();
+            opponent_unit.clear();
+            my_recycler.clear();
+            my_unit.clear();
+
+            const auto& cells = board.get_cells();
+            const int fin = Board::index(board.get_width(), board.get_height() - 1);
+            for(int id = Board::index(0, 0); id < fin; id++)
             {
-                for(int j = 0; j < board.get_height(); j++)
+                const int owner = cells.owner[id];
+                if(owner != 0 && owner != 1){continue;}//neutre ou sentinelle
+                const int x = Board::x_of(id);
+                const int y = Board::y_of(id);
+                const int units = cells.units[id];
+                if(owner == 1)
                 {
-                    if(board.get_board()(i, j).owner == 1 && board.get_board()(i, j).recycler == 1)
+                    if(cells.recycler[id] == 1){my_recycler.push_back(Entity{x, y});}
+                    if(units > 0)
                     {
-                        Entity entity;
-                        entity.x = i;
-                        entity.y = j;
-                        my_recycler.push_back(entity);
+                        my_unit.push_back(UnitStack{x, y, units});
                     }
                 }
-            }
-        }
-
-        //Function that update the array my_unit depuis le tableau board passé en paramètre
-        void update_my_unit(Board const& board)
-        {
-            for(int i = 0; i < board.get_width(); i++)
-            {
-                for(int j = 0; j < board.get_height(); j++)
+                else
                 {
-                    if(board.get_board()(i, j).owner == 1 && board.get_board()(i, j).units > 0)
+                    if(cells.recycler[id] == 1){opponent_recycler.push_back(Entity{x, y});}
+                    if(units > 0)
                     {
-                        for(int k = 0; k < board.get_board()(i, j).units; k++)
-                        {
-                            Entity entity;
-                            entity.x = i;
-                            entity.y = j;
-                            my_unit.push_back(entity);
-                        }
+                        opponent_unit.push_back(UnitStack{x, y, units});
                     }
                 }
             }
@@ -952,7 +2066,7 @@ class Entities {
             return opponent_recycler;
         }
 
-        std::vector<Entity>& get_opponent_unit() noexcept {
+        std::vector<UnitStack>& get_opponent_unit() noexcept {
             return opponent_unit;
         }
 
@@ -960,13 +2074,260 @@ class Entities {
             return my_recycler;
         }
 
-        std::vector<Entity>& get_my_unit() noexcept {
+        std::vector<UnitStack>& get_my_unit() noexcept {
             return my_unit;
         }
 };
 
 
 
+/**
+ * @brief registre des unites affectees pendant un tour : nombre de mes unites encore libres sur chaque case
+ * reserver ou liberer une unite et savoir si une case en a encore une libre se fait en O(1) ;
+ * le registre tient aussi la distance de Manhattan de chaque case a l'unite libre la plus proche,
+ * recalculee en deux passes seulement quand une case gagne ou perd sa derniere unite libre
+ * @example  UnitLedger registre;
+ *           registre.reset(entities.get_my_unit());
+ *           if(registre.is_free(x, y)){ registre.reserve(x, y); }
+ *           int d = registre.distance_to_free(x2, y2);
+ */
+class UnitLedger {
+
+    public:
+        static constexpr int AUCUNE_UNITE = 1 << 20;//distance quand plus aucune unite n'est libre
+
+    private:
+        Board::Grid<int> libres{};//par Board::index
+        int nb_libres = 0;
+        Board::Grid<int> distances_libres{};//par Board::index, distance a la case libre la plus proche
+        bool distances_a_jour = false;
+
+        /**
+         * @brief transformee de distance L1 : une passe avant (gauche, haut) puis une passe arriere (droite, bas)
+         * sur toute la grille, sentinelles comprises, ce qui evite les tests de bord autres que ceux de ligne
+         */
+        void calculer_distances()
+        {
+            constexpr int STRIDE = Board::STRIDE;
+            const int nb = static_cast<int>(distances_libres.size());
+            for(int id = 0; id < nb; id++){
+                distances_libres[id] = libres[id] > 0 ? 0 : AUCUNE_UNITE;
+            }
+            for(int id = 0; id < nb; id++){
+                int& d = distances_libres[id];
+                if((id & (STRIDE - 1)) != 0){d = std::min(d, distances_libres[id - 1] + 1);}
+                if(id >= STRIDE){d = std::min(d, distances_libres[id - STRIDE] + 1);}
+            }
+            for(int id = nb - 1; id >= 0; id--){
+                int& d = distances_libres[id];
+                if((id & (STRIDE - 1)) != STRIDE - 1){d = std::min(d, distances_libres[id + 1] + 1);}
+                if(id + STRIDE < nb){d = std::min(d, distances_libres[id + STRIDE] + 1);}
+            }
+            distances_a_jour = true;
+        }
+
+    public:
+        //toutes les unites de la liste redeviennent libres
+        void reset(const std::vector<UnitStack>& my_unit)
+        {
+            libres.fill(0);
+            nb_libres = 0;
+            for(const UnitStack& pile : my_unit){
+                libres[Board::index(pile.x, pile.y)] += pile.count;
+                nb_libres += pile.count;
+            }
+            distances_a_jour = false;
+        }
+
+        bool is_free(const int x, const int y) const noexcept {
+            return libres[Board::index(x, y)] > 0;
+        }
+
+        int get_free_on(const int x, const int y) const noexcept {
+            return libres[Board::index(x, y)];
+        }
+
+        int get_nb_free() const noexcept {
+            return nb_libres;
+        }
+
+        //affecte une unite libre de la case
+        void reserve(const int x, const int y) noexcept {
+            const int reste = --libres[Board::index(x, y)];
+            nb_libres--;
+            if(reste == 0){distances_a_jour = false;}
+        }
+
+        //rend une unite affectee de la case
+        void release(const int x, const int y) noexcept {
+            const int reste = ++libres[Board::index(x, y)];
+            nb_libres++;
+            if(reste == 1){distances_a_jour = false;}
+        }
+
+        /**
+         * @brief distance de Manhattan de la case a la case la plus proche qui a encore une unite libre
+         * @return AUCUNE_UNITE si plus aucune unite n'est libre
+         */
+        int distance_to_free(const int x, const int y)
+        {
+            if(!distances_a_jour){calculer_distances();}
+            return distances_libres[Board::index(x, y)];
+        }
+};
+
+/**
+ * @brief affectation de cout total minimal entre les lignes et les colonnes d'une matrice de couts (methode hongroise)
+ * chaque ligne recoit au plus une colonne et chaque colonne au plus une ligne ; O(n^2 m) avec n = min(lignes, colonnes)
+ * un couple de cout INTERDIT n'est jamais retenu, le solveur retient d'abord le plus de couples autorises possible ;
+ * avec un budget, la methode s'arrete quand il est epuise et les lignes restantes sont affectees en glouton
+ * @example  AssignmentSolver solveur;
+ *           Vector2d<int> couts(nb_colonnes, nb_lignes); // couts(colonne, ligne)
+ *           std::vector<int> colonne_de_ligne;
+ *           solveur.solve(couts, colonne_de_ligne, budget); // -1 pour une ligne sans colonne
+ */
+class AssignmentSolver {
+
+    public:
+        static constexpr int INTERDIT = 1 << 20;
+
+    private:
+        //tableaux de travail reutilises, indices a partir de 1 (0 = colonne fictive)
+        std::vector<int64_t> u;
+        std::vector<int64_t> v;
+        std::vector<int64_t> minv;
+        std::vector<int> p;
+        std::vector<int> way;
+        std::vector<char> used;
+        std::vector<char> colonne_prise;//colonnes deja affectees, pour la completion gloutonne
+
+        /**
+         * @brief methode hongroise pour n <= m : cout(i, j) est le cout de la ligne i vers la colonne j (0 <= i < n)
+         * les lignes sont ajoutees une a une, l'affectation des lignes deja traitees reste valide si le budget s'epuise
+         * @param colonne_de_ligne rempli avec la colonne de chaque ligne, -1 pour une ligne non traitee
+         */
+        template<typename Cout>
+        void resoudre(const int n, const int m, Cout cout, const TurnBudget& budget, std::vector<int>& colonne_de_ligne)
+        {
+            constexpr int64_t INFINI = std::numeric_limits<int64_t>::max() / 4;
+            u.assign(n + 1, 0);
+            v.assign(m + 1, 0);
+            p.assign(m + 1, 0);
+            way.assign(m + 1, 0);
+            for(int i = 1; i <= n && !budget.should_stop(); i++){
+                p[0] = i;
+                int j0 = 0;
+                minv.assign(m + 1, INFINI);
+                used.assign(m + 1, false);
+                do{
+                    used[j0] = true;
+                    const int i0 = p[j0];
+                    int64_t delta = INFINI;
+                    int j1 = 0;
+                    for(int j = 1; j <= m; j++){
+                        if(used[j]){continue;}
+                        const int64_t reduit = cout(i0 - 1, j - 1) - u[i0] - v[j];
+                        if(reduit < minv[j]){
+                            minv[j] = reduit;
+                            way[j] = j0;
+                        }
+                        if(minv[j] < delta){
+                            delta = minv[j];
+                            j1 = j;
+                        }
+                    }
+                    for(int j = 0; j <= m; j++){
+                        if(used[j]){
+                            u[p[j]] += delta;
+                            v[j] -= delta;
+                        }
+                        else{
+                            minv[j] -= delta;
+                        }
+                    }
+                    j0 = j1;
+                }while(p[j0] != 0);
+                do{
+                    const int j1 = way[j0];
+                    p[j0] = p[j1];
+                    j0 = j1;
+                }while(j0 != 0);
+            }
+            colonne_de_ligne.assign(n, -1);
+            for(int j = 1; j <= m; j++){
+                if(p[j] != 0){
+                    colonne_de_ligne[p[j] - 1] = j - 1;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @param couts couts(colonne, ligne), INTERDIT pour un couple impossible
+         * @param colonne_de_ligne redimensionne au nombre de lignes, -1 pour une ligne sans colonne
+         * @param budget verifie avant chaque ligne de la methode hongroise, illimite par defaut
+         */
+        void solve(const Vector2d<int>& couts, std::vector<int>& colonne_de_ligne, const TurnBudget& budget = TurnBudget())
+        {
+            const int nb_colonnes = static_cast<int>(couts.width());
+            const int nb_lignes = static_cast<int>(couts.height());
+            colonne_de_ligne.assign(nb_lignes, -1);
+            if(nb_lignes == 0 || nb_colonnes == 0){return;}
+
+            if(nb_lignes <= nb_colonnes){
+                resoudre(nb_lignes, nb_colonnes, [&](const int ligne, const int colonne){return couts(colonne, ligne);}, budget, colonne_de_ligne);
+            }
+            else{
+                //plus de lignes que de colonnes : on affecte les colonnes aux lignes
+                std::vector<int> ligne_de_colonne;
+                resoudre(nb_colonnes, nb_lignes, [&](const int colonne, const int ligne){return couts(colonne, ligne);}, budget, ligne_de_colonne);
+                for(int colonne = 0; colonne < nb_colonnes; colonne++){
+                    if(ligne_de_colonne[colonne] != -1){
+                        colonne_de_ligne[ligne_de_colonne[colonne]] = colonne;
+                    }
+                }
+            }
+            //les couples interdits retenus faute de mieux sont abandonnes
+            colonne_prise.assign(nb_colonnes, false);
+            for(int ligne = 0; ligne < nb_lignes; ligne++){
+                if(colonne_de_ligne[ligne] != -1 && couts(colonne_de_ligne[ligne], ligne) >= INTERDIT){
+                    colonne_de_ligne[ligne] = -1;
+                }
+                if(colonne_de_ligne[ligne] != -1){
+                    colonne_prise[colonne_de_ligne[ligne]] = true;
+                }
+            }
+            //budget epuise : chaque ligne restante prend la colonne libre la moins chere
+            //(sans effet quand la methode hongroise est allee au bout)
+            for(int ligne = 0; ligne < nb_lignes; ligne++){
+                if(colonne_de_ligne[ligne] != -1){continue;}
+                int meilleure = -1;
+                for(int colonne = 0; colonne < nb_colonnes; colonne++){
+                    if(colonne_prise[colonne] || couts(colonne, ligne) >= INTERDIT){continue;}
+                    if(meilleure == -1 || couts(colonne, ligne) < couts(meilleure, ligne)){
+                        meilleure = colonne;
+                    }
+                }
+                if(meilleure != -1){
+                    colonne_de_ligne[ligne] = meilleure;
+                    colonne_prise[meilleure] = true;
+                }
+            }
+        }
+};
+
+/**
+ * @brief une pile ennemie et son danger pour le tour : plus le score est bas, plus elle est dangereuse
+ */
+struct MenaceEnnemie
+{
+    int x;
+    int y;
+    float score;
+    int distance;//longueur du chemin vers ma case frontiere la plus proche
+    int nb_unites_adj;//unites de la pile et de ses voisines ennemies
+};
+
 class IA
 {
     private:
@@ -974,11 +2335,23 @@ class IA
         Entities entities;
         Game_data data;
         Graphe graphe;
+        CommandBatch commandes;//sortie du tour, reutilisee d'un tour a l'autre
+        DistanceField champ_frontiere;//distances vers ma case frontiere la plus proche, une fois par tour
+        std::vector<MenaceEnnemie> menaces;//piles ennemies classees de la plus dangereuse a la moins dangereuse
+        RecyclerMap carte_recyclers;//rendement d'un recycler sur chaque case, mis a jour apres chaque lecture du plateau
+        AssignmentSolver solveur_affectation;
+        Vector2d<PathSummary> matrice_captures;//chemins piles libres x cibles des phases de capture
+        Vector2d<PathSummary> matrice_spawns;//chemins cases frontieres x ennemies, partages par les paliers de spawn
+        Vector2d<int> couts_captures;//couts(cible, unite libre)
+        static constexpr size_t MAX_CIBLES_CAPTURE = 64;//borne le nombre de cibles de l'affectation, sauf s'il y a plus d'unites libres
+        TurnBudget budget;//temps restant du tour, partage entre les phases de coordinatination_action
+        PhaseTelemetry telemetrie;//durees des phases sur toute la partie
+        static constexpr TurnBudget::Clock::duration SEUIL_CAPTURE_VIDE = std::chrono::milliseconds(3);//en dessous, pas de capture des cases vides
 
     public:
         bool global_fin_early = false;
         int old_ressources = -10;
-        IA(Board & _board) : board(_board), entities(_board), graphe(&board){}
+        IA(Board & _board) : board(_board), entities(_board), graphe(&board), champ_frontiere(&board){}
 
         // Procedure : boucle principale de l'IA 
             /*- update des Data
@@ -992,9 +2365,14 @@ class IA
         void loop_game()
         {   
             data.update(); // copie pour avoir acces aux donnees general du jeu plus facilement pour l'IA dans les differentes methodes apres les initialisations
+            //l'entree du tour est arrivee : le temps de l'arbitre court
+            budget.start(data.nb_tour == 1);
             board.update();
-            entities = Entities(board);
-            graphe = Graphe(&board);
+            carte_recyclers.update(board);
+            //les entites ne dependent que des proprietaires, des unites et des recyclers
+            if(board.get_changed_fields() & (Board::OWNER | Board::UNITS | Board::RECYCLER)){
+                entities.update(board);
+            }
             action();
             //print_value_board();
         }
@@ -1011,6 +2389,8 @@ class IA
             basic_strat();
         }
 
+        const PhaseTelemetry& get_telemetry() const {return telemetrie;}
+
         //test affichage value...
         //ATTENTION : 
         void print_value_board()
@@ -1025,21 +2405,20 @@ class IA
 
         bool verif_adjacency(const int x, const int y, const int x_origine, const int y_origine)
         {
-            for(int i = 0; i < 8; i++)
+            if(!board.is_inside(x, y)){return false;}
+            const int cible = Board::index(x, y);
+            for(const int direction : Board::ORTHOGONAL)
             {
-                if(i == 1 || i == 3 || i == 4 || i == 6)//pas les diagonnales
-                {
-                    if(board.get_board()(x_origine,y_origine).neighbours[i].x == x && board.get_board()(x_origine,y_origine).neighbours[i].y == y){return true;}
-                }
+                if(Board::index(x_origine, y_origine) + direction == cible){return true;}
             }
             return false;
         }
 
         bool verif_if_cell_empty_adjecency(const int x, const int y)
         {
-            for(int i = 0; i < 8; i++)
+            for(const int direction : Board::ALL_DIRECTIONS)
             {
-                if(board.get_board()(x, y).neighbours[i].is_exist == false)
+                if(!board.is_inside(Board::index(x, y) + direction))
                 {
                     return true;
                 }
@@ -1047,135 +2426,17 @@ class IA
             return false;
         }
 
-        void calcule_min_distance_entre_my_unit_cellBoard_empty(std::vector<Position> & array_remove_value_unit_allie,std::vector<Position> const & array_remove_value,std::tuple<int, int, int> & best_position){
-            int _distance_opp_unit = -1;
-            int min = 1000;
-            int max_x_move = -1;
-            int max_y_move = -1;
-
-            std::vector<Position> copy_neutral_cells;
-            for(int i = 0; i < board.get_neutral_cells().size(); i++){
-                Position pos;
-                pos.x = board.get_neutral_cells()[i].x;
-                pos.y = board.get_neutral_cells()[i].y;
-                copy_neutral_cells.push_back(pos);}
-            
-            //Cherche dans les deux tableaux si les coordonnees du tableau passe en parametre sont present et supp si c est cas...
-            for(int i = 0; i < array_remove_value.size(); i++){
-                for(int j = 0; j < copy_neutral_cells.size(); j++){
-                    if(copy_neutral_cells[j].x == array_remove_value[i].x && copy_neutral_cells[j].y == array_remove_value[i].y){
-                        auto it = copy_neutral_cells.begin();
-                        std::advance(it, j);
-                        copy_neutral_cells.erase(it);
-                        break;}}
-            }
-
-            for(int u = 0; u < copy_neutral_cells.size(); u++){  
-                for(int i = 0; i <entities.get_my_unit().size();i++){ 
-                    if(verif_array_remove(entities.get_my_unit()[i].x,entities.get_my_unit()[i].y,array_remove_value_unit_allie))
-                            {continue;}
-                    _distance_opp_unit = distance(entities.get_my_unit()[i].x, entities.get_my_unit()[i].y, copy_neutral_cells[u].x, copy_neutral_cells[u].y);
-                
-                    //std::cerr<<"2dist : "<<_distance_opp_unit<<"\n";
-                    if(_distance_opp_unit < min)
-                    {
-                        min = _distance_opp_unit;
-                        max_x_move = copy_neutral_cells[u].x;
-                        max_y_move = copy_neutral_cells[u].y;}}
-            }
-            //std::cerr<<"finrrrr"<<max_x_move<<"/"<<max_y_move<<"\n";
-            std::get<0>(best_position) = max_x_move;
-            std::get<1>(best_position) = max_y_move;
-            std::get<2>(best_position) = min;
-        }
-
         //Add fonction pour des operations lie a l'IA afin de determiner les actions a effectuer
         //TODO...
-        void calcule_min_distance_entre_my_unit_cellBoard(std::vector<Position> & array_remove_value_unit_allie,std::vector<Position> const & array_remove_value,std::tuple<int, int, int> & best_position)
-        {
-            int _distance_opp_unit = -1;
-            int min = 1000;
-            int max_x_move = -1;
-            int max_y_move = -1;
-
-            //copie tableaux pour faire des modifs sans influencer le reste du code
-            std::vector<Position> copy_get_opponent_unit;//attention distance par rapport au case annemie et pas juste au unite ennemie(fleme changer nom)
-            for(int i = 0; i < board.get_cell_opponent().size(); i++){
-                if(board.get_cell_opponent()[i].recycler != 1 && board.get_cell_opponent()[i].units == 0){
-                    Position pos;
-                    pos.x = board.get_cell_opponent()[i].x;
-                    pos.y = board.get_cell_opponent()[i].y;
-                    copy_get_opponent_unit.push_back(pos);}}
-
-            std::vector<Position> copy_neutral_cells;
-            for(int i = 0; i < board.get_neutral_cells().size(); i++){
-                Position pos;
-                pos.x = board.get_neutral_cells()[i].x;
-                pos.y = board.get_neutral_cells()[i].y;
-                copy_neutral_cells.push_back(pos);}
-
-            //Cherche dans les deux tableaux si les coordonnees du tableau passe en parametre sont present et supp si c est cas...
-            for(int i = 0; i < array_remove_value.size(); i++){
-                bool verif = false;
-                for(int j = 0; j < copy_get_opponent_unit.size(); j++){
-                    if(copy_get_opponent_unit[j].x == array_remove_value[i].x && copy_get_opponent_unit[j].y == array_remove_value[i].y){
-                        auto it = copy_get_opponent_unit.begin();
-                        std::advance(it, j);
-                        copy_get_opponent_unit.erase(it);
-                        verif = true;
-                        break;}}
-                if(!verif){
-                    for(int j = 0; j < copy_neutral_cells.size(); j++){
-                        if(copy_neutral_cells[j].x == array_remove_value[i].x && copy_neutral_cells[j].y == array_remove_value[i].y){
-                            auto it = copy_neutral_cells.begin();
-                            std::advance(it, j);
-                            copy_neutral_cells.erase(it);
-                            verif = true;
-                            break;}}}
-            }
-
-            for(int j = 0; j < copy_get_opponent_unit.size(); j++){
-                for(int i = 0; i <entities.get_my_unit().size();i++){
-                    if(verif_array_remove(entities.get_my_unit()[i].x,entities.get_my_unit()[i].y,array_remove_value_unit_allie))
-                            {continue;}
-                    _distance_opp_unit = distance(entities.get_my_unit()[i].x, entities.get_my_unit()[i].y, copy_get_opponent_unit[j].x, copy_get_opponent_unit[j].y);
-
-                    //std::cerr<<"dist : "<<_distance_opp_unit<<"\n";
-                    if(_distance_opp_unit < min){
-                        min = _distance_opp_unit;
-                        max_x_move = copy_get_opponent_unit[j].x;
-                        max_y_move = copy_get_opponent_unit[j].y;}}  
-            }
-            
-            /*for(int u = 0; u < copy_neutral_cells.size(); u++){  
-                for(int i = 0; i <entities.get_my_unit().size();i++){ 
-                    if(verif_array_remove(entities.get_my_unit()[i].x,entities.get_my_unit()[i].y,array_remove_value_unit_allie))
-                            {continue;}
-                    _distance_opp_unit = distance(entities.get_my_unit()[i].x, entities.get_my_unit()[i].y, copy_neutral_cells[u].x, copy_neutral_cells[u].y);
-                
-                    //std::cerr<<"2dist : "<<_distance_opp_unit<<"\n";
-                    if(_distance_opp_unit < min)
-                    {
-                        min = _distance_opp_unit;
-                        max_x_move = copy_neutral_cells[u].x;
-                        max_y_move = copy_neutral_cells[u].y;}}
-            }*/
-            //std::cerr<<"finrrrr"<<max_x_move<<"/"<<max_y_move<<"\n";
-            std::get<0>(best_position) = max_x_move;
-            std::get<1>(best_position) = max_y_move;
-            std::get<2>(best_position) = min;
-        }
 
         void get_information_cell(bool version_case_adjacente, const int x, const int y, std::tuple<int, int, int,int> & information, std::vector<std::tuple<int, int, int,int>> & information_adj)
         {
             if(version_case_adjacente == true){
-                for(int k = 0; k < 8; k++){
-                    if(k == 1 || k == 3 || k == 4 || k == 6){
-                        int voisin_x = board.get_board()(x,y).neighbours[k].x;
-                        int voisin_y = board.get_board()(x,y).neighbours[k].y;
-                        if(board.get_board()(x,y).neighbours[k].x != -1 && board.get_board()(x,y).neighbours[k].y != -1){
-                            information_adj.push_back(std::make_tuple(board.get_board()(voisin_x,voisin_y).owner, board.get_board()(voisin_x,voisin_y).recycler, board.get_board()(voisin_x,voisin_y).units, board.get_board()(voisin_x,voisin_y).scrap_amount));
-                        }}}}
+                for(const int direction : Board::ORTHOGONAL){
+                    const int voisin = Board::index(x, y) + direction;
+                    if(board.is_inside(voisin)){
+                        information_adj.push_back(std::make_tuple(board.get_cells().owner[voisin], board.get_cells().recycler[voisin], board.get_cells().units[voisin], board.get_cells().scrap_amount[voisin]));
+                    }}}
                             
             else{
                 //parcourir tout les board et recuperer les infos (owner, recycler, nb unit)
@@ -1195,247 +2456,121 @@ class IA
                         break;}}}
         }
 
-        void remplir_array_position_en_or_all_dangereux(bool choice, std::vector<Position> &position_to_dodge){
+        void remplir_array_position_en_or_all_dangereux(bool choice, CellSet &position_to_dodge){
             if(choice == false){//pour allie (eviter case ennemie dangereuse)
-                auto plateau = board.get_cell_opponent();
-                for(int i = 0; i < board.get_cell_opponent().size();i++){
-                    if(plateau[i].recycler == 1 ){//|| plateau[i].units > 0){//voir pour modif si pb
-                        Position pos;
-                        pos.x = plateau[i].x;
-                        pos.y = plateau[i].y;
-                        position_to_dodge.push_back(pos);}}
+                for(const int id : board.get_cell_opponent()){
+                    if(board.get_cells().recycler[id] == 1 ){//|| units > 0){//voir pour modif si pb
+                        position_to_dodge.insert(Board::x_of(id), Board::y_of(id));}}
             }
             else{//pour ennemie(eviter case allie dangereuse)
-                auto plateau_ennemie = board.get_my_cells();
-                for(int i = 0; i < plateau_ennemie.size();i++){
-                    if(plateau_ennemie[i].recycler == 1 ){//|| plateau_ennemie[i].units > 0){//voir pour modif si besoin
-                        Position pos;
-                        pos.x = plateau_ennemie[i].x;
-                        pos.y = plateau_ennemie[i].y;
-                        position_to_dodge.push_back(pos);}}
+                for(const int id : board.get_my_cells()){
+                    if(board.get_cells().recycler[id] == 1 ){//|| units > 0){//voir pour modif si besoin
+                        position_to_dodge.insert(Board::x_of(id), Board::y_of(id));}}
             }
         }
 
         bool within_cell_opp_around(const int x, const int y)
         {
-            for(int i = 0; i < 8; i++)
-            { 
-                int x_ = board.get_board()(x,y).neighbours[i].x;
-                int y_ = board.get_board()(x,y).neighbours[i].y;
-                if(x_ != -1 && y_ != -1){
-                    if(board.get_board()(x_,y_).owner == 0 && board.get_board()(x_,y_).recycler != 1 || board.get_board()(x_,y_).owner == -1 && board.get_board()(x_,y_).scrap_amount > 0){return true;}
-                }
-            }
-            return false;
+            return board.get_mask_front().test(x, y);
         }
 
         bool within_cell_opp_around_version2(const int x, const int y)
         {
-            for(int i = 0; i < 8; i++)
-            { 
-                int x_ = board.get_board()(x,y).neighbours[i].x;
-                int y_ = board.get_board()(x,y).neighbours[i].y;
-                if(x_ != -1 && y_ != -1){
-                    if(board.get_board()(x_,y_).owner == 0 && board.get_board()(x_,y_).recycler != 1){return true;}
-                }
-            }
-            return false;
+            return board.get_mask_front_opponent().test(x, y);
         }
 
-        bool verif_pos_is_in_arraySaveDist_ennemie(const int x,const int y,const int x_inside,const int y_inside,std::vector<std::vector<std::tuple<int,int,int>>> &save_dist_ennemie,int &dist,int &_index){
-            int index = 0;
-            bool found = false;
-            bool final = false;
-            for(int i = 0; i < save_dist_ennemie.size();i++){
-                if(x == std::get<0>(save_dist_ennemie[i][0]) && y == std::get<1>(save_dist_ennemie[i][0])){index = i;found = true;_index = index;break;}
-            }    
-            if(found == true){
-                for(int j = 0; j < save_dist_ennemie[index].size();j++){
-                    if(x_inside == std::get<0>(save_dist_ennemie[index][j]) && y_inside == std::get<1>(save_dist_ennemie[index][j])){dist = std::get<2>(save_dist_ennemie[index][j]);final = true;break;}
-                }
-            }
-                    
-            if(found == true && final == true){
-                return true;
-            }
-            else{return false;}
-        }
-
-        void evaluation_ennemie_unit(std::vector<Position> &position_to_dodge,std::vector<Position> const & array_remove_value, std::tuple<int, int, int,int> & best_position,std::vector<std::vector<std::tuple<int,int,int>>> &save_dist_ennemie)
-        {
-            int _distance_opp_unit = -1;
-            int min = 1000;
-            int max = -1111;
-            int max_x_move = -1;
-            int max_y_move = -1;
-            int distance_reel = -1;
-            int nb_ennemie_adj_tot = -1;
-            float score_max = 0;
-            float score_min = 100000.0;
-            bool not_fear = false;
-
-            //copie tableaux pour faire des modifs sans influencer le reste du code
-            std::vector<std::tuple<int,int,int>> copy_get_opponent_unit;//attention distance par rapport au case annemie et pas juste au unite ennemie(fleme changer nom)
-            size_t nb_cell_opp = board.get_cell_opponent().size();
-            for(int i = 0; i < nb_cell_opp; i++){
-                auto cell = board.get_cell_opponent()[i];
-                if(cell.recycler != 1 && cell.units > 0){
-                    copy_get_opponent_unit.push_back(std::make_tuple(cell.x, cell.y, cell.units));
-                    std::vector<std::tuple<int,int,int>> temp;
-                    temp.push_back(std::make_tuple(cell.x, cell.y, 0));
-                    save_dist_ennemie.push_back(temp);
-                }
-            }
+        /**
+         * @brief classe une fois par tour toutes les piles ennemies par danger
+         * un seul BFS multi-sources depuis mes cases frontieres donne a chaque pile la distance vers la plus proche,
+         * au lieu d'un chemin par couple pile x frontiere a chaque evaluation
+         * @param position_to_dodge complete avec mes recyclers, que l'ennemie ne peut pas traverser
+         */
+        void classer_menaces_ennemies(CellSet &position_to_dodge)
+        {
+            menaces.clear();
+            const auto& cells = board.get_cells();
 
-            size_t array_remove_value_size = array_remove_value.size();
-            for(int i = 0; i < array_remove_value_size; i++){
-                size_t copy_get_opponent_unit_size = copy_get_opponent_unit.size();
-                for(int j = 0; j < copy_get_opponent_unit_size; j++){
-                    if(std::get<0>(copy_get_opponent_unit[j]) == array_remove_value[i].x && std::get<1>(copy_get_opponent_unit[j]) == array_remove_value[i].y){
-                        auto it = copy_get_opponent_unit.begin();
-                        std::advance(it, j);
-                        copy_get_opponent_unit.erase(it);
-                        break;}}}
-            
             //determiner l element le plus dangereux(score le moins eleve(-1))
             remplir_array_position_en_or_all_dangereux(true, position_to_dodge);
-            size_t copy_get_opponent_unit_size = copy_get_opponent_unit.size();
-            for(int j = 0; j < copy_get_opponent_unit_size; j++)
-            {
-                not_fear = false;
-                score_max = 0;
-                min = 1000;
-                max = -1111;
-                size_t nb_my_cells = board.get_my_cells().size();
-                for(int i = 0; i < nb_my_cells; i++){
-
-                    if(board.get_my_cells()[i].recycler != 1 && within_cell_opp_around(board.get_my_cells()[i].x, board.get_my_cells()[i].y)){
-                        int dist = -1;
-                        int index = -1;
-                        if(verif_pos_is_in_arraySaveDist_ennemie(std::get<0>(copy_get_opponent_unit[j]), std::get<1>(copy_get_opponent_unit[j]),board.get_my_cells()[i].x, board.get_my_cells()[i].y,save_dist_ennemie,dist,index)){
-                            _distance_opp_unit = dist;
-                        }
-                        else{
-                            //distance
-                            graphe.init_research_court_chemin(std::get<0>(copy_get_opponent_unit[j]), std::get<1>(copy_get_opponent_unit[j]),board.get_my_cells()[i].x, board.get_my_cells()[i].y,std::get<2>(copy_get_opponent_unit[j]),position_to_dodge);
-                            graphe.loop_search_chemin();
-                            _distance_opp_unit = graphe.get_list_chemin().size();
-                            /*std::cerr<<"--------chemin1---\n";
-                            for(std::list<Position>::iterator it = graphe.get_list_chemin().begin(); it != graphe.get_list_chemin().end(); it++){
-                                std::cerr<<"x et y : " << it->x <<"/" << it->y << std::endl;
-                            }
-                            std::cerr<<"--------chemin1---\n";*/
-                            graphe.clear_list();
-                            //std::cerr<<"index : "<<index<<std::endl;
-                            save_dist_ennemie[index].push_back(std::make_tuple(board.get_my_cells()[i].x, board.get_my_cells()[i].y,_distance_opp_unit));
-                        }
 
-                        //std::cerr<<"depart : : "<<std::get<0>(copy_get_opponent_unit[j])<<"/"<<std::get<1>(copy_get_opponent_unit[j])<<"\n";
-                        //std::cerr<<"arrive : : "<<board.get_my_cells()[i].x<<"/"<<board.get_my_cells()[i].y<<"\n";
-                        //std::cerr<<"dist : "<<_distance_opp_unit<<"\n";
-                        //_distance_opp_unit = distance(std::get<0>(copy_get_opponent_unit[j]), std::get<1>(copy_get_opponent_unit[j]),board.get_my_cells()[i].x, board.get_my_cells()[i].y);
-                        if(_distance_opp_unit != 0){
-                            if(_distance_opp_unit < min){
-                                min = _distance_opp_unit;
-                            }
-                        }
-                        
-                        if(_distance_opp_unit > max){
-                            max = _distance_opp_unit;
-                        }
-                        
-                        if(nb_my_cells - 1 == i && max == 0){not_fear = true;}
-                        //std::cerr<<"ee :"<<not_fear<<std::endl;
-                    }      
+            //mes cases au contact de l'ennemie ou du neutre
+            std::vector<Position> frontiere;
+            bool derniere_case_frontiere = false;
+            const std::span<const int> my_cells = board.get_my_cells();
+            for(size_t i = 0; i < my_cells.size(); i++){
+                const int x = Board::x_of(my_cells[i]);
+                const int y = Board::y_of(my_cells[i]);
+                if(cells.recycler[my_cells[i]] != 1 && within_cell_opp_around(x, y)){
+                    frontiere.push_back(Position(x, y));
+                    derniere_case_frontiere = (my_cells.size() - 1 == i);
                 }
-                if(not_fear == false){
-
-                    //Nb unit on the case
-                    score_max = min;
-                    float nb_unit_one_case = std::get<2>(copy_get_opponent_unit[j]);
-                    score_max -= (nb_unit_one_case/2);//coef 1
-                    //nb_unit_autour de toi
-                    int nb_unit_adj = nb_unit_one_case;
-                    std::tuple<int, int, int,int> information;
-                    std::vector<std::tuple<int, int, int,int>> information_adj;
-                    get_information_cell(true,std::get<0>(copy_get_opponent_unit[j]),std::get<1>(copy_get_opponent_unit[j]),information,information_adj);
-                    for(int k = 0; k < information_adj.size();k++){
-                        if(std::get<0>(information_adj[k]) == 0){
-                            nb_unit_adj += std::get<2>(information_adj[k]);
-                            float nb_unit = std::get<2>(information_adj[k]);
-                            score_max-= (nb_unit/4);//coef 2
-                        }
-                    }
-                    //std::cerr<<"-----------------------score :"<<score_max<<std::endl;
-                    if(score_max < score_min){
-                        score_min = score_max;
-                        max_x_move = std::get<0>(copy_get_opponent_unit[j]);
-                        max_y_move = std::get<1>(copy_get_opponent_unit[j]);
-                        distance_reel = min;
-                        nb_ennemie_adj_tot = nb_unit_adj;
-                    }
-                } 
-            }        
-            //std::cerr<<"finrrrr"<<max_x_move<<"/"<<max_y_move<<"/"<<distance_reel<<"/"<<nb_ennemie_adj_tot<<"\n";
-            std::get<0>(best_position) = max_x_move;
-            std::get<1>(best_position) = max_y_move;
-            std::get<2>(best_position) = distance_reel;
-            std::get<3>(best_position) = nb_ennemie_adj_tot;
-        }
-
-        bool verif_array_remove(const int x, const int y, std::vector<Position> &position_remove_best_alliee)
-        {
-            int compteur_1 = 0;
-            for(int i = 0; i < position_remove_best_alliee.size();i++){
-                if(x == position_remove_best_alliee[i].x && y == position_remove_best_alliee[i].y){compteur_1++;}}
-            
-            int compteur = 0;
-            for(int i = 0; i < entities.get_my_unit().size();i++){
-                if(x == entities.get_my_unit()[i].x && y == entities.get_my_unit()[i].y){compteur++;}
             }
-
-            if(compteur_1 == compteur){return true;}
-            else{return false;}
-
-            /*for(int i = 0; i < position_remove_best_alliee.size();i++)
-            {
-                if(x == position_remove_best_alliee[i].x && y == position_remove_best_alliee[i].y){return true;}
+            champ_frontiere.compute(frontiere, position_to_dodge);
+
+            for(const int id : board.get_cell_opponent()){
+                if(cells.recycler[id] == 1 || cells.units[id] <= 0){continue;}
+                const int x = Board::x_of(id);
+                const int y = Board::y_of(id);
+                const int distance_frontiere = champ_frontiere.path_length(x, y);//0 si aucune frontiere atteignable
+                //pas de peur si aucune frontiere n'est atteignable
+                if(derniere_case_frontiere && distance_frontiere == 0){continue;}
+
+                //Nb unit on the case
+                float score = distance_frontiere == 0 ? 1000 : distance_frontiere;
+                float nb_unit_one_case = cells.units[id];
+                score -= (nb_unit_one_case/2);//coef 1
+                //nb_unit_autour de toi
+                int nb_unit_adj = nb_unit_one_case;
+                std::tuple<int, int, int,int> information;
+                std::vector<std::tuple<int, int, int,int>> information_adj;
+                get_information_cell(true, x, y, information, information_adj);
+                for(const auto& voisine : information_adj){
+                    if(std::get<0>(voisine) == 0){
+                        nb_unit_adj += std::get<2>(voisine);
+                        float nb_unit = std::get<2>(voisine);
+                        score-= (nb_unit/4);//coef 2
+                    }
+                }
+                menaces.push_back(MenaceEnnemie{x, y, score, distance_frontiere == 0 ? 1000 : distance_frontiere, nb_unit_adj});
             }
-            return false;*/
+            //a score egal, l'ordre des cases ennemies decide comme avant
+            std::stable_sort(menaces.begin(), menaces.end(), [](const MenaceEnnemie& a, const MenaceEnnemie& b){
+                return a.score < b.score;
+            });
         }
 
-        bool verif_pos_is_in_arraySaveDist(bool get_dist,const int x,const int y,std::vector<std::tuple<int,int,int,int,int>> &save_dist, int &dist,int &getx,int &gety){
-            if(get_dist == true){
-                for(int i = 0; i < save_dist.size();i++){
-                    if(x == std::get<0>(save_dist[i]) && y == std::get<1>(save_dist[i])){dist = std::get<2>(save_dist[i]);getx = std::get<3>(save_dist[i]);gety = std::get<4>(save_dist[i]); break;}
-                } 
-                return false;//ne veux rien dire pour ce cas...
-            }
-            else{
-                for(int i = 0; i < save_dist.size();i++){
-                    if(x == std::get<0>(save_dist[i]) && y == std::get<1>(save_dist[i])){return true;}
-                }
-                return false;
+        /**
+         * @brief la pile ennemie la plus dangereuse qui n'a pas encore ete traitee
+         * @param best_position x,y,distance,nb_ennemie(+adj), -1 partout s'il n'en reste aucune
+         */
+        void evaluation_ennemie_unit(CellSet const & array_remove_value, std::tuple<int, int, int,int> & best_position)
+        {
+            best_position = std::make_tuple(-1, -1, -1, -1);
+            for(const MenaceEnnemie& menace : menaces){
+                if(array_remove_value.contains(menace.x, menace.y)){continue;}
+                best_position = std::make_tuple(menace.x, menace.y, menace.distance, menace.nb_unites_adj);
+                return;
             }
         }
 
-        void repartir_allie_on_unit_ennemie(std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie)
+        void repartir_allie_on_unit_ennemie(UnitLedger &registre_unites, CellSet &position_remove_best_ennemie,CellSet &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie)
         {
             std::tuple<int, int, int,int> best_position_ennemie = std::make_tuple(-1, -1, -1,-1);//x,y,dist,nb_ennemie(+adj)
-            std::vector<std::vector<std::tuple<int,int,int>>> save_dist_ennemie;
-            auto started = std::chrono::high_resolution_clock::now();
-            while(true){
+            std::vector<PathSummary> resultats_inverse;//resume du chemin de chaque unite vers l ennemie
+            classer_menaces_ennemies(position_to_dodge);
+            while(!budget.should_stop()){
                 int compteur = 0;
-                std::vector<std::tuple<int,int,int,int,int>> save_dist;//x,y,dist
                 int get_dist = 0;
-                bool leave_loop = false;
                 //std::cerr<<"ok\n";
                 //Recup ennemie le plus dangereux
-                evaluation_ennemie_unit(position_to_dodge,position_remove_best_ennemie,best_position_ennemie,save_dist_ennemie);
+                evaluation_ennemie_unit(position_remove_best_ennemie,best_position_ennemie);
                 //std::cerr<<"ok1\n";
                 if(std::get<0>(best_position_ennemie) == -1 && std::get<1>(best_position_ennemie) == -1){break;}
                 //Enregistrer dans array pour ne pas le reselectionner
-                position_remove_best_ennemie.push_back(Position(std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
+                position_remove_best_ennemie.insert(Position(std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
+                //un seul parcours depuis l'ennemie pour avoir la distance et le premier pas de toutes mes unites
+                const auto& My_unit = entities.get_my_unit();
+                graphe.search_from_target(std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie),My_unit,position_to_dodge,resultats_inverse);
                 //traiter un ennemie
                 for(int j = 1; j <= std::get<3>(best_position_ennemie);j++)
                 {
@@ -1444,31 +2579,13 @@ class IA
                     int y_best = -1;
                     int origine_x = -1;
                     int origine_y = -1;
-                    auto My_unit = entities.get_my_unit();
                     for(int i = 0; i < My_unit.size();i++){
-                        if(verif_array_remove(My_unit[i].x,My_unit[i].y,position_remove_best_alliee))
+                        if(!registre_unites.is_free(My_unit[i].x, My_unit[i].y))
                             {continue;}
 
-                        int x,y;
-                        if(!verif_pos_is_in_arraySaveDist(false,My_unit[i].x,My_unit[i].y,save_dist,get_dist,x,y)){
-                            //std::cerr<<"not save\n";
-                            //Recherche chemin
-                            graphe.init_research_court_chemin(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie), 1,position_to_dodge);
-                            graphe.loop_search_chemin();
-                            get_dist = graphe.get_list_chemin().size();
-                            for(auto Position :graphe.get_list_chemin()){
-                                x = Position.x;
-                                y = Position.y;
-                                break;
-                            }
-                            graphe.clear_list();
-                            //Save dans list
-                            save_dist.push_back(std::make_tuple(My_unit[i].x,My_unit[i].y,get_dist,x,y));
-                        }
-                        else{
-                            verif_pos_is_in_arraySaveDist(true,My_unit[i].x,My_unit[i].y,save_dist,get_dist,x,y);
-                            //std::cerr<<"ici:::"<<My_unit[i].x<<"/"<<My_unit[i].y<<"//"<<x<<"/"<<y<<"\n";
-                        }
+                        get_dist = resultats_inverse[i].length;
+                        int x = resultats_inverse[i].first_step.x;
+                        int y = resultats_inverse[i].first_step.y;
                         //int dist = distance(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie));
                         if(get_dist != 0){
                             if(get_dist < min){
@@ -1482,15 +2599,13 @@ class IA
                     }
                     if(x_best == -1 && y_best == -1){
                         array_move_ennemie.push_back(std::make_tuple(std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie),std::get<3>(best_position_ennemie) - compteur,std::get<2>(best_position_ennemie)));
-                        //leave_loop = true;
                         //std::cerr<<"1\n";
                         break;
                     }
                     else{
                         //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
                         array_move_allie.push_back(std::make_tuple(1,origine_x,origine_y,x_best,y_best));
-                        //position_remove_best_alliee.push_back(Position(x_best,y_best));
-                        position_remove_best_alliee.push_back(Position(origine_x,origine_y));
+                        registre_unites.reserve(origine_x,origine_y);
                         compteur++;
                         //std::cerr<<"2\n";
                     }
@@ -1498,15 +2613,11 @@ class IA
                         array_move_ennemie.push_back(std::make_tuple(std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie),std::get<3>(best_position_ennemie) - j,std::get<2>(best_position_ennemie)));
                     }
                 }
-                //if(leave_loop == true){break;}
             }
-            auto done = std::chrono::high_resolution_clock::now();
-            std::string s = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done-started).count());
-            // std::cerr<<"temps into repartir ennemie-------------- : "<<s<<std::endl;
             //Prendre le reste des unite dispo si il y en a et prendre l'avantage
-            if(position_remove_best_alliee.size() != entities.get_my_unit().size()){
+            if(registre_unites.get_nb_free() != 0){
                 //std::cerr<<"test : 2\n";
-                for(int j = 0; j<array_move_ennemie.size();j++){
+                for(int j = 0; j<array_move_ennemie.size() && !budget.should_stop();j++){
                     //std::cerr<<"test : 3\n";
                     if(std::get<2>(array_move_ennemie[j]) == 0){
                         //std::cerr<<"test : 5\n";
@@ -1515,22 +2626,15 @@ class IA
                         int y_best = -1;
                         int origine_x = -1;
                         int origine_y = -1;
-                        auto My_unit = entities.get_my_unit();
+                        const auto& My_unit = entities.get_my_unit();
+                        graphe.search_from_target(std::get<0>(array_move_ennemie[j]),std::get<1>(array_move_ennemie[j]),My_unit,position_to_dodge,resultats_inverse);
                         for(int i = 0; i < My_unit.size();i++){
-                            if(verif_array_remove(My_unit[i].x,My_unit[i].y,position_remove_best_alliee))
+                            if(!registre_unites.is_free(My_unit[i].x, My_unit[i].y))
                                 {continue;}
-                                
-                            graphe.init_research_court_chemin(My_unit[i].x, My_unit[i].y, std::get<0>(array_move_ennemie[j]),std::get<1>(array_move_ennemie[j]), 1,position_to_dodge);
-                            graphe.loop_search_chemin();
-                            int dist = graphe.get_list_chemin().size();//distance(My_unit[i].x, My_unit[i].y, std::get<0>(array_move_ennemie[j]),std::get<1>(array_move_ennemie[j]));//
-                            int x,y;
-                            for(auto Position :graphe.get_list_chemin()){
-                                x = Position.x;
-                                y = Position.y;
-                                break;
-                            }
-                            //std::cerr<<x<<"/"<<y<<std::endl;
-                            graphe.clear_list();
+
+                            int dist = resultats_inverse[i].length;
+                            int x = resultats_inverse[i].first_step.x;
+                            int y = resultats_inverse[i].first_step.y;
                             //int dist = distance(My_unit[i].x, My_unit[i].y, std::get<0>(array_move_ennemie[j]),std::get<1>(array_move_ennemie[j]));
                             if(dist != 0){
                                 //std::cerr<<"sdfdf\n";
@@ -1546,8 +2650,7 @@ class IA
                         if(x_best != -1 && y_best != -1){
                             //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(array_move_ennemie[j]),std::get<1>(array_move_ennemie[j])));
                             array_move_allie.push_back(std::make_tuple(1,origine_x,origine_y,x_best,y_best));
-                            //position_remove_best_alliee.push_back(Position(x_best,y_best));
-                            position_remove_best_alliee.push_back(Position(origine_x,origine_y));
+                                registre_unites.reserve(origine_x,origine_y);
                             std::get<2>(array_move_ennemie[j]) = -1;
                             //std::cerr<<"test : 4\n";
                         }
@@ -1557,192 +2660,142 @@ class IA
             //std::cerr<<"finish\n";
         }
 
-        void move_capture(std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie)
+        /**
+         * @brief affecte en une fois les unites libres aux cases cibles en minimisant la somme des longueurs de chemin
+         * une ligne par unite libre (les unites d'une meme pile partagent leurs couts), une colonne par cible ;
+         * seules les cibles les plus proches d'une unite libre sont considerees : au moins MAX_CIBLES_CAPTURE,
+         * et jamais moins que d'unites libres pour que chacune puisse recevoir sa cible. Le cout de la methode hongroise
+         * croit donc avec le nombre d'unites libres : elle s'arrete a la fin de la tranche du budget et les unites
+         * restantes sont affectees en glouton
+         * @param cibles les cases a capturer, tronquees si besoin
+         */
+        void affecter_captures(std::vector<Position> &cibles, UnitLedger &registre_unites, CellSet &position_to_dodge, std::vector<std::tuple<int, int, int,int,int>> &array_move_allie)
         {
-            std::tuple<int, int, int> best_position_global = std::make_tuple(-1, -1, -1);//x,y,dist,nb_ennemie(+adj)
-            std::vector<Position> array_remove_global;
-            while(true){
-                //Chercher case plus proche pour capture
-                //std::cerr<<"move capture 1 en\n";
-                calcule_min_distance_entre_my_unit_cellBoard(position_remove_best_alliee,array_remove_global,best_position_global);
-                //std::cerr<<"move capture 2 en\n";
-                if(std::get<0>(best_position_global) == -1 && std::get<1>(best_position_global) == -1){break;}
-                
-                int min = 10000;
-                int x_best = -1;
-                int y_best = -1;
-                int origine_x = -1;
-                int origine_y = -1;
-                auto My_unit = entities.get_my_unit();
-                for(int i = 0; i < My_unit.size();i++){
-                    if(verif_array_remove(My_unit[i].x,My_unit[i].y,position_remove_best_alliee))
-                        {continue;}
-
-                    int x,y;
-                    //Recherche chemin
-                    graphe.init_research_court_chemin(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_global),std::get<1>(best_position_global), 1,position_to_dodge);
-                    graphe.loop_search_chemin();
-                    int dist = graphe.get_list_chemin().size();
-                    for(auto Position :graphe.get_list_chemin()){
-                        x = Position.x;
-                        y = Position.y;
-                        break;
-                    }
-                    graphe.clear_list();
-                    
-                    //int dist = distance(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie));
-                    if(dist != 0){
-                        if(dist < min){
-                            min = dist;
-                            x_best = x;//My_unit[i].x;//x;
-                            y_best = y;// My_unit[i].y;//y;
-                            origine_x = My_unit[i].x;
-                            origine_y = My_unit[i].y;
-                        }
-                    }
+            std::vector<Position> piles_libres;
+            for(const UnitStack& pile : entities.get_my_unit()){
+                if(registre_unites.is_free(pile.x, pile.y)){
+                    piles_libres.push_back(Position(pile.x, pile.y));
                 }
-                if(x_best != -1 && y_best != -1){
-                    //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
-                    array_move_allie.push_back(std::make_tuple(1,origine_x,origine_y,x_best,y_best));
-                    //position_remove_best_alliee.push_back(Position(x_best,y_best));
-                    position_remove_best_alliee.push_back(Position(origine_x,origine_y));
-                    //Enregistrer dans array pour ne pas le reselectionner
-                    array_remove_global.push_back(Position(std::get<0>(best_position_global),std::get<1>(best_position_global)));
-                    //std::cerr<<"capturer\n";
+            }
+            if(piles_libres.empty() || cibles.empty()){return;}
+
+            const size_t nb_cibles_max = std::max(MAX_CIBLES_CAPTURE, static_cast<size_t>(registre_unites.get_nb_free()));
+            if(cibles.size() > nb_cibles_max){
+                //distance a l'unite libre la plus proche lue sur la carte du registre, a egalite l'ordre des cases decide
+                std::vector<std::pair<int, int>> proximite;//distance, indice de la cible
+                for(size_t t = 0; t < cibles.size(); t++){
+                    proximite.push_back(std::make_pair(registre_unites.distance_to_free(cibles[t].x, cibles[t].y), static_cast<int>(t)));
                 }
-                else
-                {
-                    array_remove_global.push_back(Position(std::get<0>(best_position_global),std::get<1>(best_position_global)));
+                std::partial_sort(proximite.begin(), proximite.begin() + nb_cibles_max, proximite.end());
+                std::vector<Position> plus_proches;
+                for(size_t k = 0; k < nb_cibles_max; k++){
+                    plus_proches.push_back(cibles[proximite[k].second]);
                 }
+                cibles.swap(plus_proches);
             }
-        }
 
-        void move_capture_empty(std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie){
-            std::tuple<int, int, int> best_position_global = std::make_tuple(-1, -1, -1);//x,y,dist,nb_ennemie(+adj)
-            std::vector<Position> array_remove_global;
-            while(true){
-                //Chercher case plus proche pour capture
-                //std::cerr<<"move capture 1 neutre\n";
-                calcule_min_distance_entre_my_unit_cellBoard_empty(position_remove_best_alliee,array_remove_global,best_position_global);
-                //std::cerr<<"move capture 2 neutre\n";
-                if(std::get<0>(best_position_global) == -1 && std::get<1>(best_position_global) == -1){break;}
-                
-                int min = 10000;
-                int x_best = -1;
-                int y_best = -1;
-                int origine_x = -1;
-                int origine_y = -1;
-                auto My_unit = entities.get_my_unit();
-                for(int i = 0; i < My_unit.size();i++){
-                    if(verif_array_remove(My_unit[i].x,My_unit[i].y,position_remove_best_alliee))
-                        {continue;}
-
-                    int x,y;
-                    //Recherche chemin
-                    graphe.init_research_court_chemin(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_global),std::get<1>(best_position_global), 1,position_to_dodge);
-                    graphe.loop_search_chemin();
-                    int dist = graphe.get_list_chemin().size();
-                    for(auto Position :graphe.get_list_chemin()){
-                        x = Position.x;
-                        y = Position.y;
-                        break;
-                    }
-                    graphe.clear_list();
-                    
-                    //int dist = distance(My_unit[i].x, My_unit[i].y, std::get<0>(best_position_global),std::get<1>(best_position_global));
-                    if(dist != 0){
-                        if(dist < min){
-                            min = dist;
-                            x_best = x;//My_unit[i].x;//x;
-                            y_best = y;//My_unit[i].y;//y;
-                            origine_x = My_unit[i].x;
-                            origine_y = My_unit[i].y;
-                        }
-                    }
+            //un parcours par cible ou par pile, puis les couts d'une ligne par unite libre
+            graphe.search_batch(piles_libres, cibles, position_to_dodge, matrice_captures);
+            std::vector<size_t> pile_de_ligne;
+            for(size_t s = 0; s < piles_libres.size(); s++){
+                for(int k = 0; k < registre_unites.get_free_on(piles_libres[s].x, piles_libres[s].y); k++){
+                    pile_de_ligne.push_back(s);
                 }
-                if(x_best != -1 && y_best != -1){
-                    //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_global),std::get<1>(best_position_global)));
-                    array_move_allie.push_back(std::make_tuple(1,origine_x,origine_y,x_best,y_best));
-                    //position_remove_best_alliee.push_back(Position(x_best,y_best));
-                    position_remove_best_alliee.push_back(Position(origine_x,origine_y));
-                    //Enregistrer dans array pour ne pas le reselectionner
-                    array_remove_global.push_back(Position(std::get<0>(best_position_global),std::get<1>(best_position_global)));
-                    //std::cerr<<"capturer neutre\n";
-                }
-                else
-                {
-                    array_remove_global.push_back(Position(std::get<0>(best_position_global),std::get<1>(best_position_global)));
+            }
+            couts_captures.resize(cibles.size(), pile_de_ligne.size());
+            for(size_t ligne = 0; ligne < pile_de_ligne.size(); ligne++){
+                for(size_t t = 0; t < cibles.size(); t++){
+                    const int dist = matrice_captures(t, pile_de_ligne[ligne]).length;
+                    couts_captures(t, ligne) = dist != 0 ? dist : AssignmentSolver::INTERDIT;
                 }
             }
+
+            std::vector<int> cible_de_ligne;
+            solveur_affectation.solve(couts_captures, cible_de_ligne, budget);
+            for(size_t ligne = 0; ligne < pile_de_ligne.size(); ligne++){
+                const int t = cible_de_ligne[ligne];
+                if(t == -1){continue;}
+                const Position& origine = piles_libres[pile_de_ligne[ligne]];
+                const Position premier_pas = matrice_captures(t, pile_de_ligne[ligne]).first_step;
+                array_move_allie.push_back(std::make_tuple(1,origine.x,origine.y,premier_pas.x,premier_pas.y));
+                registre_unites.reserve(origine.x, origine.y);
+            }
+        }
+
+        void move_capture(UnitLedger &registre_unites,CellSet &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie)
+        {
+            //cases ennemies vides et sans recycler
+            std::vector<Position> cibles;
+            const auto& cells = board.get_cells();
+            for(const int id : board.get_cell_opponent()){
+                if(cells.recycler[id] != 1 && cells.units[id] == 0){
+                    cibles.push_back(Position(Board::x_of(id), Board::y_of(id)));}}
+            affecter_captures(cibles, registre_unites, position_to_dodge, array_move_allie);
+        }
+
+        void move_capture_empty(UnitLedger &registre_unites,CellSet &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie){
+            //cases neutres
+            std::vector<Position> cibles;
+            for(const int id : board.get_neutral_cells()){
+                cibles.push_back(Position(Board::x_of(id), Board::y_of(id)));}
+            affecter_captures(cibles, registre_unites, position_to_dodge, array_move_allie);
         }
 
         void coordinatination_action(std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<Position> &array_spawn,std::vector<Position> &array_recycler)
         {
             //Add : faire en sorte de faire eventuellement plus fois early game , spawn quand plus ennemie sur case allie
             std::vector<std::tuple<int,int,int,int>> array_move_ennemie;//x,y,nombre restant(0 egalite, 1,2...-> manque 2, -1 un de plus),dist plus proche avec case allie
-            std::vector<Position> position_to_dodge;//x,y, allie
+            CellSet position_to_dodge;//cases a eviter pour les allies
             remplir_array_position_en_or_all_dangereux(false,position_to_dodge);//case a eviter pour les alliee
-            std::vector<Position> position_remove_best_ennemie;//x,y
-            std::vector<Position> position_remove_best_alliee;//x,y
+            CellSet position_remove_best_ennemie;//ennemies deja traites
+            UnitLedger registre_unites;//unites encore libres par case
+            registre_unites.reset(entities.get_my_unit());
 
-            auto started = std::chrono::high_resolution_clock::now();
-            //Fonction de built les plus evident pour les recyclers
-            construct_recycler_early_game(array_recycler,array_spawn,position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            constrcut_recycler_defense(array_recycler,array_spawn,position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done = std::chrono::high_resolution_clock::now();
-            std::string s = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done-started).count());
-            // std::cerr<<"temps-------------- : "<<s<<std::endl;
-
-            auto started_2 = std::chrono::high_resolution_clock::now();
-            //Fonction pour les move de defenses
-            repartir_allie_on_unit_ennemie(position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_2 = std::chrono::high_resolution_clock::now();
-            std::string s_2 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_2-started_2).count());
-            // std::cerr<<"temps-------------- : "<<s_2<<std::endl;
-
-            auto started_3 = std::chrono::high_resolution_clock::now();
-            //Spawn (si dans les spawn je vois que meme en mettant les spwan, j ai pas assez (ennemie distance 1), ceux deja mis sont reallouer pour aller faire le move de capture, à la place on fera des built)
-            spawn_defense(array_spawn,position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_3 = std::chrono::high_resolution_clock::now();
-            std::string s_3 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_3-started_3).count());
-            // std::cerr<<"temps-------------- : "<<s_3<<std::endl;
-
-            auto started_4 = std::chrono::high_resolution_clock::now();
-            //Spawn prendre avantage
-            spawn_to_take_advantages(array_spawn,position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_4 = std::chrono::high_resolution_clock::now();
-            std::string s_4 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_4-started_4).count());
-            // std::cerr<<"temps-------------- : "<<s_4<<std::endl;
+            //chaque bloc est une phase mesuree par la telemetrie
+            {
+                ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::RECYCLERS);
+                //Fonction de built les plus evident pour les recyclers
+                construct_recycler_early_game(array_recycler,position_to_dodge);
+                constrcut_recycler_defense(array_recycler,position_to_dodge);
+            }
+            {
+                ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::DEFENSE);
+                //Fonction pour les move de defenses : au plus 60% du temps restant, le reste pour les spawns et les captures
+                budget.begin_phase(0.6);
+                repartir_allie_on_unit_ennemie(registre_unites,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
+            }
+            budget.begin_phase(1.0);
+            {
+                ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::SPAWNS);
+                //Spawn (si dans les spawn je vois que meme en mettant les spwan, j ai pas assez (ennemie distance 1), ceux deja mis sont reallouer pour aller faire le move de capture, à la place on fera des built)
+                //Spawn de defense, de parite puis d'avantage selon la matiere restante
+                //(ne depend pas des moves de capture : fait avant elles pour ne pas etre perdu si le temps manque)
+                planifier_spawns(array_spawn,position_to_dodge,array_move_ennemie);
+            }
 
             //Built de secour sur ceux qui etait impossibel(ces ennemie sera forcement a une distance de 1)
             //...
 
-            auto started_5 = std::chrono::high_resolution_clock::now();
-            //move de capture ennemie
-            move_capture(position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_5 = std::chrono::high_resolution_clock::now();
-            std::string s_5 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_5-started_5).count());
-            // std::cerr<<"temps-------------- : "<<s_5<<std::endl;
-
-            auto started_6 = std::chrono::high_resolution_clock::now();
-            //move de capture case vide
-            move_capture_empty(position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_6 = std::chrono::high_resolution_clock::now();
-            std::string s_6 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_6-started_6).count());
-            // std::cerr<<"temps-------------- : "<<s_6<<std::endl;
+            {
+                ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::CAPTURE);
+                //move de capture ennemie : une seule affectation, au plus 70% du temps restant, le reste pour les cases vides
+                budget.begin_phase(0.7);
+                move_capture(registre_unites,position_to_dodge,array_move_allie);
+            }
 
-            auto started_7 = std::chrono::high_resolution_clock::now();
-            //Spawn et built si il reste des ressources
-            spawn_to_take_must_advantages(array_spawn,position_remove_best_alliee,position_remove_best_ennemie,position_to_dodge,array_move_allie,array_move_ennemie);
-            auto done_7 = std::chrono::high_resolution_clock::now();
-            std::string s_7 = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done_7-started_7).count());
-            // std::cerr<<"temps-------------- : "<<s_7<<std::endl;
+            //move de capture case vide : la phase la moins utile, sautee si le tour est presque fini
+            if(budget.is_short(SEUIL_CAPTURE_VIDE)){return;}
+            {
+                ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::CAPTURE_VIDE);
+                //idem avec tout le temps restant
+                budget.begin_phase(1.0);
+                move_capture_empty(registre_unites,position_to_dodge,array_move_allie);
+            }
         }
 
         void to_do_action()
         {
             auto started = std::chrono::high_resolution_clock::now();
-            bool action = false;
             std::vector<std::tuple<int, int, int,int,int>> array_move_allie;//amount,x,y,x_dest,y_dest
             std::vector<Position> array_spawn;
             std::vector<Position> array_recycler;
@@ -1756,72 +2809,58 @@ class IA
             //Construction
             for (int i = 0; i < array_recycler.size(); i++)
             {
-                Command recycler(Command::BUILD, 1, -1,-1,-1,-1,array_recycler[i].x, array_recycler[i].y);
-                action = true;
+                commandes.build(array_recycler[i].x, array_recycler[i].y);
             }
             //construct_recycler_early_game(action);
             //Spawn
             for (int i = 0; i < array_spawn.size(); i++)
             {
-                Command spawn(Command::SPAWN, 1, -1,-1,-1,-1,array_spawn[i].x, array_spawn[i].y);
-                action = true;
+                commandes.spawn(1, array_spawn[i].x, array_spawn[i].y);
             }
             
             //Move defense
             for (int i = 0; i < array_move_allie.size(); i++)
             {
-                Command move(Command::MOVE,std::get<0>(array_move_allie[i]), std::get<1>(array_move_allie[i]), std::get<2>(array_move_allie[i]), std::get<3>(array_move_allie[i]), std::get<4>(array_move_allie[i]), -1, -1);
-                action = true;
+                commandes.move(std::get<0>(array_move_allie[i]), std::get<1>(array_move_allie[i]), std::get<2>(array_move_allie[i]), std::get<3>(array_move_allie[i]), std::get<4>(array_move_allie[i]));
             }
             //Wait
-            if(!action)
+            if(commandes.empty())
             {
-                Command waitCommand(Command::WAIT);
+                commandes.wait();
             }
             //Message info
             auto done = std::chrono::high_resolution_clock::now();
             std::string s = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(done-started).count());
-            Command messageCommand(Command::MESSAGE,s);
+            commandes.message(s);
             std::cerr<<s<<std::endl;
-            //Fin message
-            std::cout << std::endl; 
+            telemetrie.set_cache_stats(graphe.get_cache_hits(), graphe.get_cache_misses());
+            telemetrie.record(PhaseTelemetry::TOUR, budget.elapsed());
+            //Fin message : tout le tour part en une seule ecriture
+            commandes.flush();
         }
 
-        void constrcut_recycler_defense(std::vector<Position> &array_recycler,std::vector<Position> &array_spawn,std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie){
-            for(int i = 0; i < board.get_my_cells().size();i++)
+        void constrcut_recycler_defense(std::vector<Position> &array_recycler,CellSet &position_to_dodge){
+            const auto& cells = board.get_cells();
+            for(const int id : board.get_my_cells())
             {
-                if(board.get_my_cells()[i].can_build == 1 && data.my_matter >= 10)
+                if(cells.can_build[id] == 1 && data.my_matter >= 10)
                 {
-                    bool verif = false;
-                    int x_origine = board.get_my_cells()[i].x;
-                    int y_origine = board.get_my_cells()[i].y;
-                    for(int j = 0; j < 8; j++)
-                    {
-                        if(board.get_my_cells()[i].neighbours[j].is_exist == true){
-                            int x_voisin = board.get_board()(x_origine,y_origine).neighbours[j].x;
-                            int y_voisin = board.get_board()(x_origine,y_origine).neighbours[j].y;
-                            if(j == 1 || j == 3 || j == 4 || j == 6)//pas les diagonnales
-                            {
-                                if(board.get_board()(x_voisin,y_voisin).units > 0 && board.get_board()(x_voisin,y_voisin).owner == 0){verif = true;break;}
-                            }
-                        } 
-                    }
-                    if(verif){
-                    position_to_dodge.push_back(Position(board.get_my_cells()[i].x,board.get_my_cells()[i].y));
-                    array_recycler.push_back(Position(board.get_my_cells()[i].x,board.get_my_cells()[i].y));
+                    if(carte_recyclers.get_adjacent_enemies(id) > 0){
+                    position_to_dodge.insert(Position(Board::x_of(id),Board::y_of(id)));
+                    array_recycler.push_back(Position(Board::x_of(id),Board::y_of(id)));
                     data.my_matter -=10;
-                    }//std::cerr<<"recyclr ok "<<board.get_my_cells()[i].x<<"/"<<board.get_my_cells()[i].y<<std::endl;}
+                    }//std::cerr<<"recyclr ok "<<Board::x_of(id)<<"/"<<Board::y_of(id)<<std::endl;}
                 }        
             }
         }
 
-        void construct_recycler_early_game(std::vector<Position> &array_recycler,std::vector<Position> &array_spawn,std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie)//rajout tableau coor fait pour que les autre sache qu il ne faut pas joueur la
+        void construct_recycler_early_game(std::vector<Position> &array_recycler,CellSet &position_to_dodge)//rajout tableau coor fait pour que les autre sache qu il ne faut pas joueur la
         {
-            const auto& My_cell =  board.get_my_cells();
-            const auto& array_global = board.get_board();
+            const std::span<const int> My_cell =  board.get_my_cells();
+            const auto& cells = board.get_cells();
             bool present = false;
-            for(int i = 0; i < board.get_my_cells().size();i++){
-                if(within_cell_opp_around_version2(My_cell[i].x,My_cell[i].y)){present = true;break;}}
+            for(const int id : My_cell){
+                if(within_cell_opp_around_version2(Board::x_of(id),Board::y_of(id))){present = true;break;}}
 
             if(present){global_fin_early = true;}
             //std::cerr<<"recyclr early "<<present<<std::endl;
@@ -1830,43 +2869,20 @@ class IA
                 int x = -1;
                 int y = -1;
                 //std::cerr<<"ok "<<std::endl;
-                for(int i = 0; i < My_cell.size();i++){
-                    //std::cerr<<"my recycler "<<My_cell[i].x<<"/"<<My_cell[i].y<<std::endl;
-                    if(My_cell[i].recycler != 1 && My_cell[i].units == 0 && My_cell[i].scrap_amount > 1){
-                        //std::cerr<<"my recycler "<<My_cell[i].x<<"/"<<My_cell[i].y<<std::endl;
-                        int scrapt_amount_ = My_cell[i].scrap_amount;
-                        int score = scrapt_amount_; 
-                        //Note case voisine
-                        for(int j = 0; j < 8; j++){
-                            if(j == 1 || j == 3 || j == 4 || j == 6){
-                                int x_voisin = My_cell[i].neighbours[j].x;
-                                int y_voisin = My_cell[i].neighbours[j].y;
-                                //std::cerr<<"nombre : "<<array_global(x_voisin,y_voisin).scrap_amount<< "compare base /"<<scrapt_amount_<<std::endl;
-                                //Analyse case
-                                if(array_global(x_voisin,y_voisin).scrap_amount == 0){
-                                    score -= scrapt_amount_;
-                                }
-                                else if(array_global(x_voisin,y_voisin).scrap_amount > scrapt_amount_){
-                                    score -= (array_global(x_voisin,y_voisin).scrap_amount - scrapt_amount_);
-                                }
-                                else if(array_global(x_voisin,y_voisin).scrap_amount < scrapt_amount_){
-                                    score += (scrapt_amount_ - array_global(x_voisin,y_voisin).scrap_amount);
-                                }
-                                else{
-                                    score -= 4;
-                                }
-                            }
-                        }
+                for(const int id : My_cell){
+                    if(cells.recycler[id] != 1 && cells.units[id] == 0 && cells.scrap_amount[id] > 1){
+                        //note des ecarts de ferraille avec les voisines, lue sur la carte des recyclers
+                        const int score = carte_recyclers.get_score(id);
                         if(score > max){
                             max = score;
-                            x = My_cell[i].x;
-                            y = My_cell[i].y;
+                            x = Board::x_of(id);
+                            y = Board::y_of(id);
                             //std::cerr<<"max "<< max<<"x :"<<x<<"/"<<y<<std::endl;
                         }
                     }
                 }
                 if(x != -1 && y != -1){
-                    position_to_dodge.push_back(Position(x,y));
+                    position_to_dodge.insert(Position(x,y));
                     array_recycler.push_back(Position(x,y));
                     data.my_matter -=10;
                     //std::cerr<<"recyclr ok "<<x<<"/"<<y<<std::endl;
@@ -1875,118 +2891,70 @@ class IA
             }
         }
 
-        bool present_dodge_tab(int x,int y,std::vector<Position> &position_to_dodge){
-            for(int i = 0; i < position_to_dodge.size();i++){
-                if(x == position_to_dodge[i].x && y == position_to_dodge[i].y){return true;}
+        /**
+         * @brief place les spawns du tour par paliers, a partir d'une seule table de distances ennemies x frontiere
+         *  - defense : il manque des unites face a l'ennemie (reste > 0)
+         *  - parite : egalite face a l'ennemie (reste == 0), un spawn pour prendre l'avantage
+         *  - avantage : deja en surnombre (reste < 0), un spawn de plus s'il reste au moins 20 de matiere
+         * un spawn se fait sur ma case frontiere la plus proche de l'ennemie et coute 10 de matiere,
+         * jamais au dela de la matiere disponible
+         */
+        void planifier_spawns(std::vector<Position> &array_spawn,CellSet &position_to_dodge,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie)
+        {
+            //mes cases ou un spawn peut aller au contact : frontiere, sans recycler, hors des cases a eviter
+            std::vector<Position> frontiere;
+            for(const int id : board.get_my_cells()){
+                const int x = Board::x_of(id);
+                const int y = Board::y_of(id);
+                if(board.get_cells().recycler[id] == 1 || !within_cell_opp_around(x, y) || position_to_dodge.contains(x, y))
+                    {continue;}
+                frontiere.push_back(Position(x, y));
             }
-            return false;
-        }
-
-        void spawn_defense(std::vector<Position> &array_spawn,std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie){
-            for(int i = 0; i < array_move_ennemie.size();i++){
-                //std::cerr<<"affcihage spawn tab x: "<<std::get<0>(array_move_ennemie[i])<<"/y :"<<std::get<1>(array_move_ennemie[i])<<"/ nb :"<<std::get<2>(array_move_ennemie[i])<<std::endl;
-                if(std::get<2>(array_move_ennemie[i]) > 0 && data.my_matter >= 10){
-                    for(int j = 0; j < std::get<2>(array_move_ennemie[i]);j++){
-                        int min = 10000;
-                        int origine_x = -1;
-                        int origine_y = -1;
-                        auto My_unit = board.get_my_cells();
-                        for(int p = 0; p < My_unit.size();p++){
-                            if(My_unit[p].recycler == 1 || !within_cell_opp_around(My_unit[p].x, My_unit[p].y) || present_dodge_tab(My_unit[p].x, My_unit[p].y,position_to_dodge))
-                                {continue;}
-
-                            //Recherche chemin
-                            graphe.init_research_court_chemin(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]), 1,position_to_dodge);
-                            graphe.loop_search_chemin();
-                            int dist = graphe.get_list_chemin().size();
-                            graphe.clear_list();
-                            //int dist = distance(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]));
-                            if(dist != 0){
-                                if(dist < min){
-                                    min = dist;
-                                    origine_x = My_unit[p].x;
-                                    origine_y = My_unit[p].y;
-                                }
-                            }
-                        }
-                        if(origine_x != -1 && origine_y != -1){
-                            //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
-                            array_spawn.push_back(Position(origine_x,origine_y));
-                            std::get<2>(array_move_ennemie[i]) -= 1;
-                            //std::cerr<<"spawn defense effectue\n";
-                            data.my_matter -= 10;}}}
+            std::vector<Position> cibles;
+            for(const auto& ennemie : array_move_ennemie){
+                cibles.push_back(Position(std::get<0>(ennemie), std::get<1>(ennemie)));
             }
-        }
-
-        void spawn_to_take_advantages(std::vector<Position> &array_spawn,std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie){
-            for(int i = 0; i < array_move_ennemie.size();i++){
-                //std::cerr<<"affcihage spawn take advantages tab x: "<<std::get<0>(array_move_ennemie[i])<<"/y :"<<std::get<1>(array_move_ennemie[i])<<"/ nb :"<<std::get<2>(array_move_ennemie[i])<<std::endl;
-                if(std::get<2>(array_move_ennemie[i]) == 0 && data.my_matter >= 10){
-                    //for(int j = 0; j > -1;j--){
-                        int min = 10000;
-                        int origine_x = -1;
-                        int origine_y = -1;
-                        auto My_unit = board.get_my_cells();
-                        for(int p = 0; p < My_unit.size();p++){
-                            if(My_unit[p].recycler == 1 || !within_cell_opp_around(My_unit[p].x, My_unit[p].y)|| present_dodge_tab(My_unit[p].x, My_unit[p].y,position_to_dodge))
-                                {continue;}
+            if(frontiere.empty() || cibles.empty()){return;}
 
-                            //Recherche chemin
-                            graphe.init_research_court_chemin(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]), 1,position_to_dodge);
-                            graphe.loop_search_chemin();
-                            int dist = graphe.get_list_chemin().size();
-                            graphe.clear_list();
-                            //int dist = distance(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]));
-                            if(dist != 0){
-                                if(dist < min){
-                                    min = dist;
-                                    origine_x = My_unit[p].x;
-                                    origine_y = My_unit[p].y;
-                                }
-                            }
-                        }
-                        if(origine_x != -1 && origine_y != -1){
-                            //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
-                            array_spawn.push_back(Position(origine_x,origine_y));
-                            std::get<2>(array_move_ennemie[i]) -= 1;
-                            //std::cerr<<"spawn defense effectue\n";
-                            data.my_matter -= 10;}}//}
+            //un seul calcul pour les trois paliers : la case de spawn de chaque ennemie est la premiere case
+            //frontiere a la plus petite distance non nulle
+            graphe.search_batch(frontiere, cibles, position_to_dodge, matrice_spawns);
+            std::vector<int> spawn_de_cible(cibles.size(), -1);
+            for(size_t t = 0; t < cibles.size(); t++){
+                int min = 10000;
+                for(size_t f = 0; f < frontiere.size(); f++){
+                    const int dist = matrice_spawns(t, f).length;
+                    if(dist != 0 && dist < min){
+                        min = dist;
+                        spawn_de_cible[t] = static_cast<int>(f);
+                    }
+                }
             }
-        }
-
-        void spawn_to_take_must_advantages(std::vector<Position> &array_spawn,std::vector<Position> &position_remove_best_alliee, std::vector<Position> &position_remove_best_ennemie,std::vector<Position> &position_to_dodge,std::vector<std::tuple<int, int, int,int,int>> &array_move_allie,std::vector<std::tuple<int,int,int,int>> &array_move_ennemie){
-            for(int i = 0; i < array_move_ennemie.size();i++){
-                //std::cerr<<"affcihage spawn must_advantage tab x: "<<std::get<0>(array_move_ennemie[i])<<"/y :"<<std::get<1>(array_move_ennemie[i])<<"/ nb :"<<std::get<2>(array_move_ennemie[i])<<std::endl;
-                if(std::get<2>(array_move_ennemie[i]) < 0 && data.my_matter >= 20){
-                    //for(int j = 0; j > std::get<2>(array_move_ennemie[i]);j--){
-                        int min = 10000;
-                        int origine_x = -1;
-                        int origine_y = -1;
-                        auto My_unit = board.get_my_cells();
-                        for(int p = 0; p < My_unit.size();p++){
-                            if(My_unit[p].recycler == 1 || !within_cell_opp_around(My_unit[p].x, My_unit[p].y)|| present_dodge_tab(My_unit[p].x, My_unit[p].y,position_to_dodge))
-                                {continue;}
-
-                            //Recherche chemin
-                            graphe.init_research_court_chemin(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]), 1,position_to_dodge);
-                            graphe.loop_search_chemin();
-                            int dist = graphe.get_list_chemin().size();
-                            graphe.clear_list();
-                            //int dist = distance(My_unit[p].x, My_unit[p].y, std::get<0>(array_move_ennemie[i]),std::get<1>(array_move_ennemie[i]));
-                            if(dist != 0){
-                                if(dist < min){
-                                    min = dist;
-                                    origine_x = My_unit[p].x;
-                                    origine_y = My_unit[p].y;
-                                }
-                            }
-                        }
-                        if(origine_x != -1 && origine_y != -1){
-                            //array_move_allie.push_back(std::make_tuple(1,x_best,y_best,std::get<0>(best_position_ennemie),std::get<1>(best_position_ennemie)));
-                            array_spawn.push_back(Position(origine_x,origine_y));
-                            std::get<2>(array_move_ennemie[i]) -= 1;
-                            //std::cerr<<"spawn defense effectue\n";
-                            data.my_matter -= 10;}}//}
+            auto spawner = [&](const size_t t){
+                array_spawn.push_back(frontiere[spawn_de_cible[t]]);
+                std::get<2>(array_move_ennemie[t]) -= 1;
+                data.my_matter -= 10;
+            };
+
+            //Spawn defense
+            for(size_t t = 0; t < array_move_ennemie.size(); t++){
+                if(spawn_de_cible[t] == -1){continue;}
+                //spawner decremente le manque : on boucle jusqu'a ce qu'il soit comble ou que la matiere manque
+                while(std::get<2>(array_move_ennemie[t]) > 0 && data.my_matter >= 10){
+                    spawner(t);
+                }
+            }
+            //Spawn prendre avantage sur les egalites
+            for(size_t t = 0; t < array_move_ennemie.size(); t++){
+                if(std::get<2>(array_move_ennemie[t]) == 0 && data.my_matter >= 10 && spawn_de_cible[t] != -1){
+                    spawner(t);
+                }
+            }
+            //Spawn si il reste des ressources
+            for(size_t t = 0; t < array_move_ennemie.size(); t++){
+                if(std::get<2>(array_move_ennemie[t]) < 0 && data.my_matter >= 20 && spawn_de_cible[t] != -1){
+                    spawner(t);
+                }
             }
         }
 
@@ -2003,10 +2971,16 @@ int main(){
     //----------------------------------NOUVEAU----------------------------------//
     Board board;
     IA ia(board);
-    while(1)
-    {
-        ia.loop_game();
+    try{
+        while(1)
+        {
+            ia.loop_game();
+        }
+    }
+    catch(const EndOfInput&){
+        //fin de l'entree : la partie est terminee
     }
+    ia.get_telemetry().dump(std::cerr);
     return 0;
 }
 #endif
@@ -73,6 +73,581 @@ TEST(DistanceTest, DistanceCenterTest){
 
 
 
+//----------------------------------TEST FIXEDGRID----------------------------------//
+TEST(FixedGridTest, IndexEtStockage){
+    using Grille = FixedGrid<int, 24, 12>;
+    static_assert(Grille::STRIDE == 32);
+    static_assert(Grille::SHIFT == 5);
+    static_assert(Grille::CAPACITY == 32 * 12);
+    static_assert(Grille::index(3, 2) == 67);
+
+    Grille grille;
+    EXPECT_EQ(grille(23, 11), 0);
+    grille.fill(7);
+    grille(3, 2) = 42;
+    EXPECT_EQ(grille[Grille::index(3, 2)], 42);
+    EXPECT_EQ(grille(4, 2), 7);
+    EXPECT_EQ(std::count(grille.begin(), grille.end(), 7), Grille::CAPACITY - 1);
+}
+
+
+
+//----------------------------------TEST BITGRID----------------------------------//
+TEST(BitGridTest, Voisins){
+    BitGrid inside;
+    for(int x = 0; x < 24; x++){
+        for(int y = 0; y < 12; y++){
+            inside.set(x, y);
+        }
+    }
+
+    BitGrid centre;
+    centre.set(5, 5);
+    BitGrid voisins = centre.neighbours4(inside);
+    EXPECT_EQ(voisins.count(), 4);
+    EXPECT_TRUE(voisins.test(4, 5) && voisins.test(6, 5) && voisins.test(5, 4) && voisins.test(5, 6));
+    EXPECT_FALSE(voisins.test(5, 5));
+    EXPECT_EQ(centre.neighbours8(inside).count(), 8);
+
+    // une case sur le bord droit ne deborde pas sur la ligne suivante
+    BitGrid bord;
+    bord.set(23, 3);
+    voisins = bord.neighbours4(inside);
+    EXPECT_EQ(voisins.count(), 3);
+    EXPECT_FALSE(voisins.test(0, 4));
+
+    // une case dans le coin en haut a gauche n'a que 3 voisins en comptant les diagonales
+    BitGrid coin;
+    coin.set(0, 0);
+    EXPECT_EQ(coin.neighbours8(inside).count(), 3);
+
+    int nb_cases = 0;
+    inside.for_each([&](int, int){ nb_cases++; });
+    EXPECT_EQ(nb_cases, 24 * 12);
+}
+
+
+
+//----------------------------------TEST CELLSET----------------------------------//
+TEST(CellSetTest, Operations){
+    CellSet a;
+    CellSet b;
+    a.insert(1, 2);
+    a.insert(Position(3, 4));
+    a.insert(1, 2); // deja present
+    b.insert(3, 4);
+    b.insert(7, 0);
+
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_TRUE(a.contains(1, 2));
+    EXPECT_FALSE(a.contains(2, 1));
+    EXPECT_EQ((a | b).size(), 3);
+    EXPECT_EQ((a & b).size(), 1);
+    EXPECT_TRUE((a & b).contains(Position(3, 4)));
+
+    a.erase(1, 2);
+    EXPECT_FALSE(a.contains(1, 2));
+    EXPECT_EQ(a.hash(), (a & b).hash());
+    a.clear();
+    EXPECT_TRUE(a.empty());
+}
+
+
+
+//----------------------------------TEST COMMANDBATCH----------------------------------//
+TEST(CommandBatchTest, Formatage){
+    CommandBatch batch;
+    EXPECT_TRUE(batch.empty());
+    batch.build(3, 4);
+    batch.spawn(2, 10, 0);
+    batch.move(12, 0, 1, 23, 11);
+    batch.push(Command(Command::MOVE, 1, -1, 0, 0, 0, -1, -1));
+    batch.message("Hello");
+    EXPECT_EQ(batch.size(), 5);
+    EXPECT_EQ(batch.view(), "BUILD 3 4;SPAWN 2 10 0;MOVE 12 0 1 23 11;MOVE 1 -1 0 0 0;MESSAGE Hello;");
+
+    batch.clear();
+    batch.push(Command(Command::WAIT));
+    EXPECT_EQ(batch.view(), "WAIT;");
+    EXPECT_THROW(Command(Command::WAIT, "oups"), std::invalid_argument);
+}
+
+
+
+//----------------------------------TEST INPUTREADER----------------------------------//
+TEST(InputReaderTest, Entiers){
+    {
+        cinInjector injector("12 -7\n0 1 -1\r\n");
+        InputReader& entree = InputReader::get();
+        EXPECT_EQ(entree.next_int(), 12);
+        EXPECT_EQ(entree.next_int(), -7);
+        std::array<int, 3> valeurs;
+        entree.next_ints(valeurs);
+        EXPECT_EQ(valeurs[0], 0);
+        EXPECT_EQ(valeurs[1], 1);
+        EXPECT_EQ(valeurs[2], -1);
+        EXPECT_THROW(entree.next_int(), EndOfInput);
+    }
+    // un nouvel injecteur repart de zero, sans restes du precedent
+    cinInjector injector("42 3");
+    EXPECT_EQ(InputReader::get().next_int(), 42);
+}
+
+// injecte l'entree puis lit un seul entier : deux appels successifs placent l'injecteur a la meme adresse
+static int premier_entier(const char* entree){
+    cinInjector injector(entree);
+    return InputReader::get().next_int();
+}
+
+TEST(InputReaderTest, InjecteursSuccessifs){
+    EXPECT_EQ(premier_entier("1 2 3"), 1);
+    EXPECT_EQ(premier_entier("42"), 42);
+    EXPECT_EQ(premier_entier("-5\n6"), -5);
+}
+
+
+
+//----------------------------------TEST TURNBUDGET----------------------------------//
+TEST(TurnBudgetTest, TranchesDuTour){
+    TurnBudget budget;
+    EXPECT_FALSE(budget.should_stop());//pas encore demarre : illimite
+
+    budget.start(std::chrono::milliseconds(0));
+    EXPECT_TRUE(budget.should_stop());
+    EXPECT_EQ(budget.remaining(), TurnBudget::Clock::duration::zero());
+
+    budget.start(std::chrono::seconds(10));
+    EXPECT_FALSE(budget.should_stop());
+    EXPECT_FALSE(budget.is_short(std::chrono::seconds(1)));
+    budget.begin_phase(0.0);
+    EXPECT_TRUE(budget.should_stop());
+    budget.begin_phase(0.5);
+    EXPECT_FALSE(budget.should_stop());
+}
+
+
+
+//----------------------------------TEST PHASETELEMETRY----------------------------------//
+TEST(PhaseTelemetryTest, Percentiles){
+    PhaseTelemetry telemetrie;
+    for(int i = 1; i <= 100; i++){
+        telemetrie.record(PhaseTelemetry::CAPTURE, std::chrono::microseconds(i * 100));
+    }
+    const PhaseTelemetry::Resume resume = telemetrie.summary(PhaseTelemetry::CAPTURE);
+    EXPECT_EQ(resume.nb, 100);
+    EXPECT_EQ(resume.p50, 5000);
+    EXPECT_EQ(resume.p95, 9500);
+    EXPECT_EQ(resume.p99, 9900);
+    EXPECT_EQ(resume.max, 10000);
+    EXPECT_EQ(resume.histogramme[0], 1);//100us
+    EXPECT_EQ(resume.histogramme[5], 50);//entre 5ms et 10ms
+    EXPECT_EQ(telemetrie.summary(PhaseTelemetry::DEFENSE).nb, 0);
+
+    {
+        ScopedPhaseTimer chrono(telemetrie, PhaseTelemetry::TOUR);
+    }
+    EXPECT_EQ(telemetrie.summary(PhaseTelemetry::TOUR).nb, 1);
+
+    telemetrie.set_cache_stats(3, 2);
+    std::ostringstream sortie;
+    telemetrie.dump(sortie);
+    EXPECT_NE(sortie.str().find("cache_chemins hits 3 misses 2\n"), std::string::npos);
+}
+
+
+
+//----------------------------------TEST BOARD----------------------------------//
+TEST(BoardTest, LectureDesCases){
+    cinInjector injector("3 2\n"
+                         "5 1 2 0 1 1 0\n9 -1 0 0 0 0 0\n1 0 0 1 0 0 1\n"
+                         "0 -1 0 0 0 0 0\n4 0 130 0 0 0 1\n3 -1 0 0 0 0 0\n");
+    Board board;
+    board.update();
+
+    EXPECT_EQ(board.get_board()(0, 0).owner, 1);
+    EXPECT_EQ(board.get_board()(0, 0).units, 2);
+    EXPECT_EQ(board.get_board()(0, 0).can_spawn, 1);
+    EXPECT_EQ(board.get_board()(2, 0).recycler, 1);
+    EXPECT_EQ(board.get_board()(1, 1).units, 130);
+    EXPECT_EQ(board.get_board()(1, 1).x, 1);
+    EXPECT_EQ(board.get_board()(1, 1).y, 1);
+    // voisins par decalage d'indice : les sentinelles autour du plateau sont des trous
+    const int coin = Board::index(0, 0);
+    EXPECT_FALSE(board.is_inside(coin + Board::ORTHOGONAL[Board::LEFT]));
+    EXPECT_FALSE(board.is_inside(coin + Board::ORTHOGONAL[Board::UP]));
+    EXPECT_EQ(coin + Board::ORTHOGONAL[Board::DOWN], Board::index(0, 1));
+    EXPECT_EQ(board.get_cells().units[coin + Board::DIAGONAL[3]], 130);
+    EXPECT_FALSE(board.is_inside(Board::index(2, 0) + Board::ORTHOGONAL[Board::RIGHT]));
+    EXPECT_EQ(board.get_cells().scrap_amount[Board::index(2, 0) + Board::ORTHOGONAL[Board::RIGHT]], 0);
+    EXPECT_FALSE(board.is_walkable(Board::index(0, 1) + Board::ORTHOGONAL[Board::DOWN]));
+
+    EXPECT_EQ(board.get_my_cells().size(), 1);
+    EXPECT_EQ(board.get_cell_opponent().size(), 2);
+    EXPECT_EQ(board.get_neutral_cells().size(), 2);
+    EXPECT_EQ(board.get_cell_opponent()[0], Board::index(2, 0));
+    EXPECT_EQ(board.get_cell_opponent()[1], Board::index(1, 1));
+    EXPECT_TRUE(board.get_mask_walkable().test(1, 0));
+    EXPECT_FALSE(board.get_mask_walkable().test(0, 1));
+}
+
+TEST(BoardTest, JournalDesChangements){
+    cinInjector injector("2 1\n"
+                         "5 1 1 0 0 0 0\n5 -1 0 0 0 0 0\n"
+                         "5 1 1 0 0 0 0\n5 -1 0 0 0 0 0\n"
+                         "5 1 1 0 0 0 0\n1 1 0 1 0 0 0\n");
+    Board board;
+    board.update();
+    EXPECT_EQ(board.get_changes().size(), 2);
+
+    // tour identique : rien ne change
+    board.update();
+    EXPECT_TRUE(board.get_changes().empty());
+    EXPECT_EQ(board.get_changed_fields(), 0);
+
+    // un recycler apparait sur la case (1,0) : elle change de proprietaire, de scrap et de praticabilite
+    board.update();
+    ASSERT_EQ(board.get_changes().size(), 1);
+    EXPECT_EQ(board.get_changes()[0].id, Board::index(1, 0));
+    EXPECT_EQ(board.get_changes()[0].fields, Board::OWNER | Board::SCRAP | Board::RECYCLER | Board::WALKABLE);
+    EXPECT_EQ(board.get_my_cells().size(), 2);
+    EXPECT_TRUE(board.get_changed_fields() & Board::WALKABLE);
+}
+
+
+
+
+//----------------------------------TEST RECYCLERMAP----------------------------------//
+TEST(RecyclerMapTest, NoteEtMiseAJour){
+    cinInjector injector("2 1\n"
+                         "5 1 1 0 0 0 0\n5 -1 0 0 0 0 0\n"
+                         "5 1 1 0 0 0 0\n1 1 0 1 0 0 0\n");
+    Board board;
+    RecyclerMap carte;
+    board.update();
+    carte.update(board);
+    const int gauche = Board::index(0, 0);
+    const int droite = Board::index(1, 0);
+    EXPECT_EQ(carte.get_score(gauche), 5 - 4 - 5 * 3);
+
+    // seule la case (1,0) change : elle et sa voisine sont recalculees
+    board.update();
+    carte.update(board);
+    EXPECT_EQ(carte.get_score(gauche), 5 + 4 - 5 * 3);
+    EXPECT_EQ(carte.get_score(droite), 1 - 4 - 3);
+}
+
+TEST(RecyclerMapTest, EnnemiesAdjacentes){
+    cinInjector injector("3 2\n"
+                         "5 1 2 0 1 1 0\n9 -1 0 0 0 0 0\n1 0 0 1 0 0 1\n"
+                         "0 -1 0 0 0 0 0\n4 0 130 0 0 0 1\n3 -1 0 0 0 0 0\n");
+    Board board;
+    board.update();
+    RecyclerMap carte;
+    carte.update(board);
+    EXPECT_EQ(carte.get_adjacent_enemies(Board::index(1, 0)), 130);
+    EXPECT_EQ(carte.get_adjacent_enemies(Board::index(0, 0)), 0);
+}
+
+
+
+
+//----------------------------------TEST GRAPHE----------------------------------//
+// plateau 3x3 de cases neutres (scrap 5) avec un trou au centre
+static const char* plateau_3x3 =
+    "3 3\n"
+    "5 -1 0 0 0 0 0\n5 -1 0 0 0 0 0\n5 -1 0 0 0 0 0\n"
+    "5 -1 0 0 0 0 0\n0 -1 0 0 0 0 0\n5 -1 0 0 0 0 0\n"
+    "5 -1 0 0 0 0 0\n5 -1 0 0 0 0 0\n5 -1 0 0 0 0 0\n";
+
+TEST(GrapheTest, RechercheDepuisLaCible){
+    cinInjector injector(plateau_3x3);
+    Board board;
+    board.update();
+    Graphe graphe(&board);
+    CellSet to_dodge;
+    to_dodge.insert(1, 0);
+
+    // vers (2,2) : le coin (0,0) doit passer par (0,1), (2,1) est voisine, (2,2) est deja sur la cible
+    const std::vector<Position> sources = {Position(0, 0), Position(2, 1), Position(2, 2)};
+    std::vector<PathSummary> resultats;
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    ASSERT_EQ(resultats.size(), 3);
+    EXPECT_TRUE(resultats[0].reachable);
+    EXPECT_EQ(resultats[0].length, 4);
+    EXPECT_EQ(resultats[0].first_step.x, 0);
+    EXPECT_EQ(resultats[0].first_step.y, 1);
+    EXPECT_TRUE(resultats[1].reachable);
+    EXPECT_EQ(resultats[1].length, 1);
+    EXPECT_EQ(resultats[1].first_step.x, 2);
+    EXPECT_EQ(resultats[1].first_step.y, 2);
+    EXPECT_TRUE(resultats[2].reachable);
+    EXPECT_EQ(resultats[2].length, 1);
+    EXPECT_EQ(resultats[2].first_step.x, 2);
+    EXPECT_EQ(resultats[2].first_step.y, 2);
+
+    // en bloquant aussi (0,1), le coin n'a plus de chemin
+    to_dodge.insert(0, 1);
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    EXPECT_FALSE(resultats[0].reachable);
+    EXPECT_EQ(resultats[0].length, 0);
+    EXPECT_EQ(resultats[0].first_step.x, -1);
+    EXPECT_EQ(resultats[0].first_step.y, -1);
+    EXPECT_EQ(resultats[1].length, 1);
+}
+
+TEST(GrapheTest, CacheDuTour){
+    cinInjector injector(std::string(plateau_3x3) + (plateau_3x3 + 4));// deux tours identiques, sans repeter "3 3"
+    Board board;
+    board.update();
+    Graphe graphe(&board);
+    CellSet to_dodge;
+    const std::vector<Position> sources = {Position(0, 0)};
+    std::vector<PathSummary> resultats;
+
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    EXPECT_EQ(graphe.get_cache_misses(), 1);
+    EXPECT_EQ(graphe.get_cache_hits(), 1);
+    EXPECT_EQ(resultats[0].length, 4);
+
+    // un autre ensemble de cases a eviter est un autre parcours
+    to_dodge.insert(1, 0);
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    EXPECT_EQ(graphe.get_cache_misses(), 2);
+
+    // la recherche groupee par cible lit les memes parcours
+    Vector2d<PathSummary> matrice;
+    graphe.search_batch(sources, std::vector<Position>{Position(2, 2)}, to_dodge, matrice);
+    EXPECT_EQ(graphe.get_cache_hits(), 2);
+    EXPECT_EQ(matrice(0, 0).length, 4);
+    EXPECT_EQ(matrice(0, 0).first_step.y, 1);
+
+    // les deux ensembles restent en cache pour la meme cible
+    to_dodge.erase(1, 0);
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    EXPECT_EQ(graphe.get_cache_hits(), 3);
+    EXPECT_EQ(graphe.get_cache_misses(), 2);
+
+    // au tour suivant le cache repart de zero
+    board.update();
+    graphe.search_from_target(2, 2, sources, to_dodge, resultats);
+    EXPECT_EQ(graphe.get_cache_misses(), 3);
+    EXPECT_EQ(graphe.get_cache_hits(), 3);
+
+    // cache plein : les parcours suivants ne sont pas gardes et ne chassent pas les premiers
+    auto ensemble = [](const int bits){
+        CellSet cases;
+        for(int b = 0; b < 6; b++){
+            if(bits & (1 << b)){cases.insert(b % 3, b / 3);}
+        }
+        return cases;
+    };
+    for(int bits = 0; bits <= 32; bits++){
+        graphe.search_from_target(2, 2, sources, ensemble(bits), resultats);
+    }
+    EXPECT_EQ(graphe.get_cache_misses(), 3 + 32);// l'ensemble vide etait deja en cache
+    graphe.search_from_target(2, 2, sources, ensemble(32), resultats);
+    EXPECT_EQ(graphe.get_cache_misses(), 3 + 33);
+    graphe.search_from_target(2, 2, sources, ensemble(1), resultats);
+    EXPECT_EQ(graphe.get_cache_hits(), 4 + 1);
+}
+
+TEST(GrapheTest, RechercheGroupee){
+    cinInjector injector(plateau_3x3);
+    Board board;
+    board.update();
+    Graphe graphe(&board);
+    DistanceField champ(&board);
+    CellSet to_dodge;
+    to_dodge.insert(1, 0);
+
+    // plus de cibles que de sources (parcours par source) puis l'inverse (parcours par cible),
+    // comparees au parcours inverse d'un DistanceField
+    std::vector<Position> peu = {Position(0, 0), Position(2, 2)};
+    std::vector<Position> beaucoup = {Position(0, 0), Position(2, 0), Position(0, 2), Position(1, 1), Position(1, 0)};
+    Vector2d<PathSummary> matrice;
+    for(int sens = 0; sens < 2; sens++){
+        const std::vector<Position>& sources = sens == 0 ? peu : beaucoup;
+        const std::vector<Position>& cibles = sens == 0 ? beaucoup : peu;
+        graphe.search_batch(sources, cibles, to_dodge, matrice);
+        for(size_t t = 0; t < cibles.size(); t++){
+            champ.compute(cibles[t], to_dodge);
+            for(size_t s = 0; s < sources.size(); s++){
+                PathSummary attendu = champ.summary(sources[s].x, sources[s].y);
+                EXPECT_EQ(matrice(t, s).length, attendu.length);
+                EXPECT_EQ(matrice(t, s).reachable, attendu.reachable);
+            }
+        }
+    }
+    graphe.search_batch(peu, beaucoup, to_dodge, matrice);
+    EXPECT_EQ(matrice(1, 0).length, 6);// (0,0) -> (2,0) en contournant (1,0)
+    EXPECT_EQ(matrice(1, 0).first_step.x, 0);
+    EXPECT_EQ(matrice(1, 0).first_step.y, 1);
+}
+
+TEST(DistanceFieldTest, DistancesAutourDuTrou){
+    cinInjector injector(plateau_3x3);
+    Board board;
+    board.update();
+    DistanceField champ(&board);
+    CellSet to_dodge;
+
+    // longueurs attendues vers (2,2), par ligne ; le trou au centre peut encore partir vers un voisin
+    const int attendu[3][3] = {{4, 3, 2},
+                               {3, 2, 1},
+                               {2, 1, 1}};
+    champ.compute(Position(2, 2), to_dodge);
+    for(int x = 0; x < 3; x++){
+        for(int y = 0; y < 3; y++){
+            EXPECT_EQ(champ.path_length(x, y), attendu[y][x]);
+        }
+    }
+    EXPECT_EQ(champ.get_distance(0, 0), 4);
+    EXPECT_EQ(champ.get_distance(1, 1), DistanceField::INACCESSIBLE);
+
+    // le premier pas depuis un coin est toujours sur le bord
+    Position pas = champ.first_step(0, 0);
+    EXPECT_TRUE((pas.x == 1 && pas.y == 0) || (pas.x == 0 && pas.y == 1));
+}
+
+
+
+
+//----------------------------------TEST ENTITIES----------------------------------//
+TEST(EntitiesTest, PilesDUnites){
+    cinInjector injector("3 2\n"
+                         "5 1 30 0 0 0 0\n5 0 2 0 0 0 0\n5 1 0 1 0 0 0\n"
+                         "5 1 1 0 0 0 0\n5 -1 0 0 0 0 0\n5 0 0 1 0 0 0\n");
+    Board board;
+    board.update();
+    Entities entities(board);
+
+    // une entree par case, dans l'ordre des lignes
+    ASSERT_EQ(entities.get_my_unit().size(), 2);
+    EXPECT_EQ(entities.get_my_unit()[0].count, 30);
+    EXPECT_EQ(entities.get_my_unit()[1].x, 0);
+    EXPECT_EQ(entities.get_my_unit()[1].y, 1);
+    EXPECT_EQ(entities.get_opponent_unit().size(), 1);
+    EXPECT_EQ(entities.get_opponent_unit()[0].count, 2);
+    EXPECT_EQ(entities.get_my_recycler().size(), 1);
+    EXPECT_EQ(entities.get_opponent_recycler().size(), 1);
+}
+
+
+
+
+//----------------------------------TEST UNITLEDGER----------------------------------//
+TEST(UnitLedgerTest, ReserverEtLiberer){
+    UnitLedger registre;
+    registre.reset({UnitStack{0, 0, 2}, UnitStack{2, 1, 1}});
+    EXPECT_EQ(registre.get_nb_free(), 3);
+    EXPECT_FALSE(registre.is_free(1, 1));
+
+    registre.reserve(0, 0);
+    EXPECT_TRUE(registre.is_free(0, 0));
+    registre.reserve(0, 0);
+    EXPECT_FALSE(registre.is_free(0, 0));
+    EXPECT_EQ(registre.get_nb_free(), 1);
+
+    registre.release(0, 0);
+    EXPECT_EQ(registre.get_free_on(0, 0), 1);
+    EXPECT_EQ(registre.get_nb_free(), 2);
+
+    //distance a l'unite libre la plus proche, suivie au fil des reservations
+    EXPECT_EQ(registre.distance_to_free(0, 0), 0);
+    EXPECT_EQ(registre.distance_to_free(3, 3), 3);
+    registre.reserve(2, 1);
+    EXPECT_EQ(registre.distance_to_free(3, 3), 6);
+    registre.reserve(0, 0);
+    EXPECT_EQ(registre.distance_to_free(3, 3), UnitLedger::AUCUNE_UNITE);
+}
+
+
+
+
+//----------------------------------TEST ASSIGNMENTSOLVER----------------------------------//
+TEST(AssignmentSolverTest, AffectationOptimale){
+    AssignmentSolver solveur;
+    std::vector<int> colonne_de_ligne;
+    //le glouton donnerait la colonne 0 a la ligne 0 (1 + 10), l'optimum croise (2 + 2)
+    Vector2d<int> couts(2, 2);
+    couts(0, 0) = 1; couts(1, 0) = 2;
+    couts(0, 1) = 2; couts(1, 1) = 10;
+    solveur.solve(couts, colonne_de_ligne);
+    EXPECT_EQ(colonne_de_ligne, (std::vector<int>{1, 0}));
+
+    //plus de lignes que de colonnes, et un couple interdit
+    Vector2d<int> rectangle(1, 3);
+    rectangle(0, 0) = AssignmentSolver::INTERDIT;
+    rectangle(0, 1) = 4;
+    rectangle(0, 2) = 3;
+    solveur.solve(rectangle, colonne_de_ligne);
+    EXPECT_EQ(colonne_de_ligne, (std::vector<int>{-1, -1, 0}));
+
+    Vector2d<int> impossible(1, 1);
+    impossible(0, 0) = AssignmentSolver::INTERDIT;
+    solveur.solve(impossible, colonne_de_ligne);
+    EXPECT_EQ(colonne_de_ligne, (std::vector<int>{-1}));
+
+    //budget deja epuise : toutes les lignes sont affectees en glouton, dans l'ordre
+    TurnBudget epuise;
+    epuise.start(std::chrono::milliseconds(0));
+    solveur.solve(couts, colonne_de_ligne, epuise);
+    EXPECT_EQ(colonne_de_ligne, (std::vector<int>{0, 1}));
+    solveur.solve(rectangle, colonne_de_ligne, epuise);
+    EXPECT_EQ(colonne_de_ligne, (std::vector<int>{-1, 0, -1}));
+}
+
+
+
+
+//----------------------------------TEST IA----------------------------------//
+TEST(IATest, SpawnsDeDefense){
+    // une pile ennemie de 3 unites au contact de ma seule case, sans aucune unite pour la contrer,
+    // et juste assez de matiere pour 3 spawns
+    cinInjector injector("2 1\n"
+                         "30 100\n"
+                         "5 1 0 0 0 1 0\n5 0 3 0 0 0 0\n");
+    Board board;
+    IA ia(board);
+    testing::internal::CaptureStdout();
+    ia.loop_game();
+    const std::string sortie = testing::internal::GetCapturedStdout();
+
+    // tout le manque est comble, pas seulement la moitie
+    size_t nb_spawns = 0;
+    for(size_t pos = sortie.find("SPAWN 1 0 0;"); pos != std::string::npos; pos = sortie.find("SPAWN 1 0 0;", pos + 1)){
+        nb_spawns++;
+    }
+    EXPECT_EQ(nb_spawns, 3);
+}
+
+
+TEST(IATest, ClassementDesMenaces){
+    // ma case (0,0) a la frontiere, deux piles ennemies accessibles et une pile isolee derriere un trou
+    cinInjector injector("5 1\n"
+                         "5 1 0 0 0 1 0\n5 0 2 0 0 0 0\n5 0 8 0 0 0 0\n0 -1 0 0 0 0 0\n5 0 3 0 0 0 0\n");
+    Board board;
+    board.update();
+    IA ia(board);
+    CellSet to_dodge;
+    ia.classer_menaces_ennemies(to_dodge);
+
+    // (2,0) : 2 - 8/2 - 2/4 = -2.5 ; (1,0) : 1 - 2/2 - 8/4 = -2 ; (4,0) n'atteint aucune frontiere
+    CellSet traitees;
+    std::tuple<int, int, int, int> menace;
+    ia.evaluation_ennemie_unit(traitees, menace);
+    EXPECT_EQ(menace, std::make_tuple(2, 0, 2, 10));
+    traitees.insert(2, 0);
+    ia.evaluation_ennemie_unit(traitees, menace);
+    EXPECT_EQ(menace, std::make_tuple(1, 0, 1, 10));
+    traitees.insert(1, 0);
+    ia.evaluation_ennemie_unit(traitees, menace);
+    EXPECT_EQ(menace, std::make_tuple(-1, -1, -1, -1));
+}
+
+
+
 
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);